@@ -0,0 +1,704 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_ALGORITHM_HPP)
+#define BIZWEN_ALGORITHM_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// deque
+#include "./deque.hpp"
+// simd_detail
+#include "./simd.hpp"
+// assert
+#include <cassert>
+// size_t
+#include <cstddef>
+// sort/merge/move/max/min/partition_point/find/count/equal/ranges::minmax_result
+#include <algorithm>
+// less/plus/ranges::less
+#include <functional>
+// move_iterator
+#include <iterator>
+// numeric_limits
+#include <limits>
+// ranges::subrange/contiguous_range
+#include <ranges>
+// span
+#include <span>
+// is_constant_evaluated/remove_const
+#include <type_traits>
+// move
+#include <utility>
+// vector
+#include <vector>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+// 基于块布局的算法
+// 每个桶是连续的，因此算法先在桶内用指针处理，再处理桶之间的关系
+
+namespace bizwen
+{
+namespace algorithm_detail
+{
+// 返回第pos个元素所在的桶和桶内偏移
+// 首块之外的块都从块首开始，因此可以由首桶的大小推出首元素在块内的位置
+template <typename T, typename Buckets>
+inline constexpr auto locate(Buckets const &buckets, ::std::size_t const pos) noexcept
+{
+    auto const front_size = deque_detail::block_elements_v<T> - buckets.front().size();
+    auto const [block_step, elem_step] = deque_detail::calc_pos<T>(front_size, pos);
+    struct loc_t
+    {
+        ::std::size_t bucket;
+        ::std::size_t offset;
+    };
+    return loc_t{block_step, block_step == ::std::size_t(0) ? elem_step - front_size : elem_step};
+}
+
+// 第index个桶的第一个元素在容器中的位置
+template <typename T, typename Buckets>
+inline constexpr ::std::size_t bucket_offset(Buckets const &buckets, ::std::size_t const index) noexcept
+{
+    return index == ::std::size_t(0)
+               ? ::std::size_t(0)
+               : buckets.front().size() + (index - ::std::size_t(1)) * deque_detail::block_elements_v<T>;
+}
+
+// 一次合并任务：把[a_begin, a_end)和[a_end, b_end)两个有序段合并后的第[out_lo, out_hi)个元素
+// 写入目标中对应的位置，b_end等于a_end时只是移动
+// a_lo和a_hi是这些元素中来自A的部分的范围，由split_merge_task计算
+struct merge_task
+{
+    ::std::size_t a_begin;
+    ::std::size_t a_end;
+    ::std::size_t b_end;
+    ::std::size_t out_lo;
+    ::std::size_t out_hi;
+    ::std::size_t a_lo;
+    ::std::size_t a_hi;
+};
+
+// 合并路径划分：返回合并结果的前diag个元素中来自A的个数
+template <typename I, typename Comp>
+inline constexpr ::std::size_t merge_path(I const a, ::std::size_t const a_size, I const b, ::std::size_t const b_size,
+                                          ::std::size_t const diag, Comp &comp)
+{
+    auto lo = diag > b_size ? diag - b_size : ::std::size_t(0);
+    auto hi = (::std::min)(diag, a_size);
+    while (lo < hi)
+    {
+        auto const mid = lo + (hi - lo) / ::std::size_t(2);
+        using diff_t = ::std::iter_difference_t<I>;
+        if (comp(b[static_cast<diff_t>(diag - mid - ::std::size_t(1))], a[static_cast<diff_t>(mid)]))
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + ::std::size_t(1);
+        }
+    }
+    return lo;
+}
+
+// 只读取源，因此可以和其他任务的划分并行执行
+template <typename I, typename Comp>
+inline constexpr void split_merge_task(I const src, merge_task &task, Comp &comp)
+{
+    using diff_t = ::std::iter_difference_t<I>;
+    auto const a = src + static_cast<diff_t>(task.a_begin);
+    auto const b = src + static_cast<diff_t>(task.a_end);
+    auto const a_size = task.a_end - task.a_begin;
+    auto const b_size = task.b_end - task.a_end;
+    task.a_lo = merge_path(a, a_size, b, b_size, task.out_lo, comp);
+    task.a_hi = merge_path(a, a_size, b, b_size, task.out_hi, comp);
+}
+
+template <typename I, typename O, typename Comp>
+inline constexpr void run_merge_task(I const src, O const dst, merge_task const &task, Comp &comp)
+{
+    using src_diff_t = ::std::iter_difference_t<I>;
+    using dst_diff_t = ::std::iter_difference_t<O>;
+    auto const a = src + static_cast<src_diff_t>(task.a_begin);
+    auto const b = src + static_cast<src_diff_t>(task.a_end);
+    auto const a_lo = task.a_lo;
+    auto const a_hi = task.a_hi;
+    auto const b_lo = task.out_lo - a_lo;
+    auto const b_hi = task.out_hi - a_hi;
+    ::std::merge(::std::make_move_iterator(a + static_cast<src_diff_t>(a_lo)),
+                 ::std::make_move_iterator(a + static_cast<src_diff_t>(a_hi)),
+                 ::std::make_move_iterator(b + static_cast<src_diff_t>(b_lo)),
+                 ::std::make_move_iterator(b + static_cast<src_diff_t>(b_hi)),
+                 dst + static_cast<dst_diff_t>(task.a_begin + task.out_lo), comp);
+}
+
+// 自底向上合并一层，相邻的两个段合并为一个，每个合并按chunk个元素划分为多个任务
+template <typename I, typename O, typename Comp, typename Bulk>
+inline void merge_level(I const src, O const dst, ::std::vector<::std::size_t> &bounds, ::std::size_t const chunk,
+                        Comp &comp, Bulk &bulk)
+{
+    ::std::vector<merge_task> tasks{};
+    ::std::vector<::std::size_t> next_bounds{bounds.front()};
+    auto const runs = bounds.size() - ::std::size_t(1);
+    for (auto r = ::std::size_t(0); r < runs; r += ::std::size_t(2))
+    {
+        auto const a_begin = bounds[r];
+        auto const a_end = bounds[r + ::std::size_t(1)];
+        auto const b_end = r + ::std::size_t(1) == runs ? a_end : bounds[r + ::std::size_t(2)];
+        auto const size = b_end - a_begin;
+        for (auto lo = ::std::size_t(0); lo < size; lo += chunk)
+        {
+            tasks.push_back({a_begin, a_end, b_end, lo, (::std::min)(size, lo + (::std::min)(chunk, size - lo)),
+                             ::std::size_t(0), ::std::size_t(0)});
+        }
+        next_bounds.push_back(b_end);
+    }
+    // 合并会移动源中的元素，因此所有任务都划分完毕之后才开始合并
+    bulk(tasks.size(), [&](::std::size_t const i) { split_merge_task(src, tasks[i], comp); });
+    bulk(tasks.size(), [&](::std::size_t const i) { run_merge_task(src, dst, tasks[i], comp); });
+    bounds = ::std::move(next_bounds);
+}
+
+// 先在每个桶内排序，再在两个连续缓冲区之间逐层合并，最后逐桶移回deque
+// 缓冲区使用默认分配器，避免占用arena_allocator等分配器管理的有限空间
+// bulk(n, f)调用f(0)到f(n-1)，可以并行
+template <typename T, typename Alloc, typename Comp, typename Bulk>
+inline void sort(deque<T, Alloc> &d, Comp &comp, ::std::size_t const chunk, Bulk &&bulk)
+{
+    auto buckets = d.buckets();
+    auto const count = static_cast<::std::size_t>(buckets.size());
+    bulk(count, [&](::std::size_t const i) {
+        auto const bucket = buckets.at(i);
+        ::std::sort(bucket.begin(), bucket.end(), comp);
+    });
+    if (count < ::std::size_t(2))
+    {
+        return;
+    }
+    ::std::vector<::std::size_t> bounds{::std::size_t(0)};
+    ::std::vector<T> buffer{};
+    buffer.reserve(static_cast<::std::size_t>(d.size()));
+    for (auto const bucket : buckets)
+    {
+        buffer.insert(buffer.end(), ::std::make_move_iterator(bucket.begin()), ::std::make_move_iterator(bucket.end()));
+        bounds.push_back(buffer.size());
+    }
+    // 合并的目标必须是已构造的对象，deque中剩下的已移动对象正好可以用来构造第二个缓冲区
+    ::std::vector<T> scratch{};
+    scratch.reserve(buffer.size());
+    for (auto const bucket : buckets)
+    {
+        scratch.insert(scratch.end(), ::std::make_move_iterator(bucket.begin()),
+                       ::std::make_move_iterator(bucket.end()));
+    }
+    // 每层交换源和目标
+    auto *src = buffer.data();
+    auto *dst = scratch.data();
+    while (bounds.size() > ::std::size_t(2))
+    {
+        merge_level(src, dst, bounds, chunk, comp, bulk);
+        ::std::swap(src, dst);
+    }
+    bulk(count, [&](::std::size_t const i) {
+        auto const bucket = buckets.at(i);
+        auto const offset = bucket_offset<T>(buckets, i);
+        ::std::move(src + offset, src + offset + bucket.size(), bucket.data());
+    });
+}
+
+// 先用每个桶的末元素在控制块上二分找到所在的桶，再在桶内二分
+// before(e)对有序序列是先真后假的谓词，返回第一个使before为假的元素的位置
+template <typename D, typename Before>
+inline constexpr auto partition_point(D &d, Before before)
+{
+    auto buckets = d.buckets();
+    auto lo = ::std::size_t(0);
+    auto hi = static_cast<::std::size_t>(buckets.size());
+    while (lo < hi)
+    {
+        auto const mid = lo + (hi - lo) / ::std::size_t(2);
+        if (before(buckets.at(mid).back()))
+        {
+            lo = mid + ::std::size_t(1);
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    if (lo == static_cast<::std::size_t>(buckets.size()))
+    {
+        return d.end();
+    }
+    using value_t = ::std::remove_const_t<typename D::value_type>;
+    auto const bucket = buckets.at(lo);
+    auto const offset =
+        static_cast<::std::size_t>(::std::partition_point(bucket.begin(), bucket.end(), before) - bucket.begin());
+    return d.begin() + static_cast<typename D::difference_type>(bucket_offset<value_t>(buckets, lo) + offset);
+}
+
+// 第bucket个桶中第offset个元素的迭代器
+template <typename D>
+inline constexpr auto iterator_at(D &d, ::std::size_t const bucket, ::std::size_t const offset) noexcept
+{
+    using value_t = ::std::remove_const_t<typename D::value_type>;
+    return d.begin() + static_cast<typename D::difference_type>(bucket_offset<value_t>(d.buckets(), bucket) + offset);
+}
+
+// 在一个桶内查找，返回偏移，找不到时返回桶的大小
+template <typename T, typename U>
+inline constexpr ::std::size_t find_in(::std::span<T const> const bucket, U const &value) noexcept
+{
+    if constexpr (::std::same_as<T, U> && simd_detail::vectorizable<T>)
+    {
+        if (!::std::is_constant_evaluated())
+        {
+            return static_cast<::std::size_t>(
+                simd_detail::find<true>(bucket.data(), bucket.data() + bucket.size(), value) - bucket.data());
+        }
+    }
+    return static_cast<::std::size_t>(::std::find(bucket.begin(), bucket.end(), value) - bucket.begin());
+}
+
+template <typename D, typename U>
+inline constexpr auto find(D &d, U const &value)
+{
+    using value_t = ::std::remove_const_t<typename D::value_type>;
+    auto buckets = static_cast<typename D::const_buckets_type>(d.buckets());
+    auto const count = static_cast<::std::size_t>(buckets.size());
+    for (auto i = ::std::size_t(0); i != count; ++i)
+    {
+        auto const bucket = buckets.at(i);
+        if (auto const offset = find_in<value_t>(bucket, value); offset != bucket.size())
+        {
+            return iterator_at(d, i, offset);
+        }
+    }
+    return d.end();
+}
+
+template <typename D, typename Pred>
+inline constexpr auto find_if_not(D &d, Pred &pred)
+{
+    auto buckets = d.buckets();
+    auto const count = static_cast<::std::size_t>(buckets.size());
+    for (auto i = ::std::size_t(0); i != count; ++i)
+    {
+        auto const bucket = buckets.at(i);
+        if (auto const it = ::std::find_if_not(bucket.begin(), bucket.end(), pred); it != bucket.end())
+        {
+            return iterator_at(d, i, static_cast<::std::size_t>(it - bucket.begin()));
+        }
+    }
+    return d.end();
+}
+
+// 从第bucket个桶的第offset个元素开始比较pattern，pattern可以跨越多个桶
+template <typename Buckets, typename T>
+inline constexpr bool match_at(Buckets buckets, ::std::size_t bucket, ::std::size_t offset,
+                               ::std::span<T const> pattern) noexcept
+{
+    auto const count = static_cast<::std::size_t>(buckets.size());
+    while (!pattern.empty())
+    {
+        if (bucket == count)
+        {
+            return false;
+        }
+        auto const s = buckets.at(bucket).subspan(offset);
+        auto const n = (::std::min)(s.size(), pattern.size());
+        if (!::std::equal(pattern.begin(), pattern.begin() + n, s.begin()))
+        {
+            return false;
+        }
+        pattern = pattern.subspan(n);
+        ++bucket;
+        offset = ::std::size_t(0);
+    }
+    return true;
+}
+
+// 用向量化的find定位首元素，再从该位置开始比较，比较可以跨越块边界
+template <typename D, typename T>
+inline constexpr auto search(D &d, ::std::span<T const> const pattern)
+{
+    if (pattern.empty())
+    {
+        return d.begin();
+    }
+    auto buckets = static_cast<typename D::const_buckets_type>(d.buckets());
+    auto const count = static_cast<::std::size_t>(buckets.size());
+    auto const first = pattern.front();
+    for (auto i = ::std::size_t(0); i != count; ++i)
+    {
+        auto const bucket = buckets.at(i);
+        for (auto offset = find_in<T>(bucket, first); offset != bucket.size();
+             offset += find_in<T>(bucket.subspan(offset), first))
+        {
+            if (match_at(buckets, i, offset, pattern))
+            {
+                return iterator_at(d, i, offset);
+            }
+            ++offset;
+            if (offset == bucket.size())
+            {
+                break;
+            }
+        }
+    }
+    return d.end();
+}
+// 与块布局和指令集无关的成对求和
+// 元素按在容器中的位置每256个分为一组，组内用8个累加器按位置模8累加，组之间按二叉树合并
+// 因此结果只取决于元素的值和顺序，舍入误差随元素数量对数增长
+template <typename T>
+class pairwise_accumulator
+{
+    static constexpr auto lanes = ::std::size_t(8);
+    static constexpr auto chunk = ::std::size_t(256);
+
+    T lanes_[lanes]{};
+    // 第k个元素是2^k个组的和，组数的二进制表示决定哪些层有值
+    T stack_[::std::numeric_limits<::std::size_t>::digits]{};
+    ::std::size_t depth_{};
+    ::std::size_t chunks_{};
+    ::std::size_t pos_{};
+
+    constexpr void flush_() noexcept
+    {
+        auto sum = ((lanes_[0] + lanes_[1]) + (lanes_[2] + lanes_[3])) +
+                   ((lanes_[4] + lanes_[5]) + (lanes_[6] + lanes_[7]));
+        for (auto &e : lanes_)
+        {
+            e = T();
+        }
+        for (auto c = chunks_; (c & ::std::size_t(1)) != ::std::size_t(0); c >>= 1)
+        {
+            sum = stack_[--depth_] + sum;
+        }
+        stack_[depth_++] = sum;
+        ++chunks_;
+        pos_ = ::std::size_t(0);
+    }
+
+  public:
+    // 累加get(0)到get(n-1)
+    template <typename Get>
+    constexpr void feed(::std::size_t const n, Get get) noexcept
+    {
+        auto k = ::std::size_t(0);
+        while (k != n)
+        {
+            if (pos_ % lanes == ::std::size_t(0) && n - k >= lanes)
+            {
+                // 整行累加，编译器可以将其向量化
+                auto const m = (::std::min)(n - k, chunk - pos_) / lanes * lanes;
+                for (auto const last = k + m; k != last; k += lanes)
+                {
+                    for (auto l = ::std::size_t(0); l != lanes; ++l)
+                    {
+                        lanes_[l] += get(k + l);
+                    }
+                }
+                pos_ += m;
+            }
+            else
+            {
+                lanes_[pos_ % lanes] += get(k);
+                ++k;
+                ++pos_;
+            }
+            if (pos_ == chunk)
+            {
+                flush_();
+            }
+        }
+    }
+
+    constexpr T result() noexcept
+    {
+        if (pos_ != ::std::size_t(0))
+        {
+            flush_();
+        }
+        if (depth_ == ::std::size_t(0))
+        {
+            return T();
+        }
+        auto sum = stack_[depth_ - ::std::size_t(1)];
+        for (auto i = depth_ - ::std::size_t(1); i != ::std::size_t(0); --i)
+        {
+            sum = stack_[i - ::std::size_t(1)] + sum;
+        }
+        return sum;
+    }
+};
+} // namespace algorithm_detail
+
+// 与std::sort相同，不稳定
+BIZWEN_EXPORT template <typename T, typename Alloc, typename Comp = ::std::less<>>
+inline void sort(deque<T, Alloc> &d, Comp comp = Comp())
+{
+    algorithm_detail::sort(d, comp, (::std::numeric_limits<::std::size_t>::max)(), [](::std::size_t const n, auto &&f) {
+        for (auto i = ::std::size_t(0); i != n; ++i)
+        {
+            f(i);
+        }
+    });
+}
+
+// 以下三个函数要求deque已按comp排序
+// 在桶之间二分时每次探测只读取块指针和该块的末元素，之后只在一个连续的块内二分
+
+BIZWEN_EXPORT template <typename T, typename Alloc, typename U, typename Comp = ::std::less<>>
+inline constexpr auto lower_bound(deque<T, Alloc> &d, U const &value, Comp comp = Comp())
+{
+    return algorithm_detail::partition_point(d, [&](T const &e) { return comp(e, value); });
+}
+
+BIZWEN_EXPORT template <typename T, typename Alloc, typename U, typename Comp = ::std::less<>>
+inline constexpr auto lower_bound(deque<T, Alloc> const &d, U const &value, Comp comp = Comp())
+{
+    return algorithm_detail::partition_point(d, [&](T const &e) { return comp(e, value); });
+}
+
+BIZWEN_EXPORT template <typename T, typename Alloc, typename U, typename Comp = ::std::less<>>
+inline constexpr auto upper_bound(deque<T, Alloc> &d, U const &value, Comp comp = Comp())
+{
+    return algorithm_detail::partition_point(d, [&](T const &e) { return !comp(value, e); });
+}
+
+BIZWEN_EXPORT template <typename T, typename Alloc, typename U, typename Comp = ::std::less<>>
+inline constexpr auto upper_bound(deque<T, Alloc> const &d, U const &value, Comp comp = Comp())
+{
+    return algorithm_detail::partition_point(d, [&](T const &e) { return !comp(value, e); });
+}
+
+BIZWEN_EXPORT template <typename T, typename Alloc, typename U, typename Comp = ::std::less<>>
+inline constexpr auto equal_range(deque<T, Alloc> &d, U const &value, Comp comp = Comp())
+{
+    return ::std::ranges::subrange(lower_bound(d, value, comp), upper_bound(d, value, comp));
+}
+
+BIZWEN_EXPORT template <typename T, typename Alloc, typename U, typename Comp = ::std::less<>>
+inline constexpr auto equal_range(deque<T, Alloc> const &d, U const &value, Comp comp = Comp())
+{
+    return ::std::ranges::subrange(lower_bound(d, value, comp), upper_bound(d, value, comp));
+}
+
+// 对算术类型使用向量化的比较，其他类型在每个桶内调用std::find
+BIZWEN_EXPORT template <typename T, typename Alloc, typename U>
+inline constexpr auto find(deque<T, Alloc> &d, U const &value)
+{
+    return algorithm_detail::find(d, value);
+}
+
+BIZWEN_EXPORT template <typename T, typename Alloc, typename U>
+inline constexpr auto find(deque<T, Alloc> const &d, U const &value)
+{
+    return algorithm_detail::find(d, value);
+}
+
+BIZWEN_EXPORT template <typename T, typename Alloc, typename U>
+inline constexpr bool contains(deque<T, Alloc> const &d, U const &value)
+{
+    return algorithm_detail::find(d, value) != d.end();
+}
+
+BIZWEN_EXPORT template <typename T, typename Alloc, typename U>
+inline constexpr auto count(deque<T, Alloc> const &d, U const &value)
+{
+    auto result = ::std::size_t(0);
+    for (auto const bucket : d.buckets())
+    {
+        if constexpr (::std::same_as<T, U> && simd_detail::vectorizable<T>)
+        {
+            if (!::std::is_constant_evaluated())
+            {
+                result += simd_detail::count(bucket.data(), bucket.data() + bucket.size(), value);
+                continue;
+            }
+        }
+        result += static_cast<::std::size_t>(::std::count(bucket.begin(), bucket.end(), value));
+    }
+    return static_cast<typename deque<T, Alloc>::difference_type>(result);
+}
+
+BIZWEN_EXPORT template <typename T, typename Alloc, typename Pred>
+inline constexpr auto find_if_not(deque<T, Alloc> &d, Pred pred)
+{
+    return algorithm_detail::find_if_not(d, pred);
+}
+
+BIZWEN_EXPORT template <typename T, typename Alloc, typename Pred>
+inline constexpr auto find_if_not(deque<T, Alloc> const &d, Pred pred)
+{
+    return algorithm_detail::find_if_not(d, pred);
+}
+
+// 返回第一个不等于value的元素，算术类型使用向量化的比较
+BIZWEN_EXPORT template <typename T, typename Alloc>
+inline constexpr auto find_not(deque<T, Alloc> const &d, T const &value)
+{
+    if constexpr (simd_detail::vectorizable<T>)
+    {
+        if (!::std::is_constant_evaluated())
+        {
+            auto buckets = d.buckets();
+            auto const count = static_cast<::std::size_t>(buckets.size());
+            for (auto i = ::std::size_t(0); i != count; ++i)
+            {
+                auto const bucket = buckets.at(i);
+                auto const last = bucket.data() + bucket.size();
+                if (auto const p = simd_detail::find<false>(bucket.data(), last, value); p != last)
+                {
+                    return algorithm_detail::iterator_at(d, i, static_cast<::std::size_t>(p - bucket.data()));
+                }
+            }
+            return d.end();
+        }
+    }
+    return find_if_not(d, [&value](T const &e) { return e == value; });
+}
+
+// 查找子序列，例如deque<char>中的子串，匹配可以跨越块边界
+BIZWEN_EXPORT template <typename T, typename Alloc, ::std::ranges::contiguous_range R>
+    requires ::std::same_as<::std::ranges::range_value_t<R>, T>
+inline constexpr auto search(deque<T, Alloc> &d, R const &pattern)
+{
+    return algorithm_detail::search(d, ::std::span<T const>(::std::ranges::data(pattern), ::std::ranges::size(pattern)));
+}
+
+BIZWEN_EXPORT template <typename T, typename Alloc, ::std::ranges::contiguous_range R>
+    requires ::std::same_as<::std::ranges::range_value_t<R>, T>
+inline constexpr auto search(deque<T, Alloc> const &d, R const &pattern)
+{
+    return algorithm_detail::search(d, ::std::span<T const>(::std::ranges::data(pattern), ::std::ranges::size(pattern)));
+}
+// 要求op满足结合律和交换律，与std::reduce相同
+// op是加法且U与T是相同的算术类型时在每个桶内使用向量化的求和，否则在桶内按顺序调用op
+// 浮点数的结果取决于块布局和运行时选择的指令集，需要可复现的结果时使用pairwise_sum
+BIZWEN_EXPORT template <typename T, typename Alloc, typename U = T, typename Op = ::std::plus<>>
+inline constexpr U reduce(deque<T, Alloc> const &d, U init = U(), Op op = Op())
+{
+    for (auto const bucket : d.buckets())
+    {
+        if constexpr (::std::same_as<T, U> && simd_detail::vectorizable<T> &&
+                      (::std::same_as<Op, ::std::plus<>> || ::std::same_as<Op, ::std::plus<T>>))
+        {
+            if (!::std::is_constant_evaluated())
+            {
+                init += simd_detail::sum(bucket.data(), bucket.data() + bucket.size());
+                continue;
+            }
+        }
+        for (auto const &e : bucket)
+        {
+            init = op(::std::move(init), e);
+        }
+    }
+    return init;
+}
+
+// 要求deque非空，与std::ranges::minmax相同，返回第一个最小的元素和最后一个最大的元素
+// comp是std::less且T是算术类型时使用向量化的比较，此时存在NaN的结果未指定
+BIZWEN_EXPORT template <typename T, typename Alloc, typename Comp = ::std::ranges::less>
+inline constexpr ::std::ranges::minmax_result<T> minmax(deque<T, Alloc> const &d, Comp comp = Comp())
+{
+    assert(!d.empty());
+    auto min = d.front();
+    auto max = min;
+    for (auto const bucket : d.buckets())
+    {
+        if constexpr (simd_detail::vectorizable<T> &&
+                      (::std::same_as<Comp, ::std::ranges::less> || ::std::same_as<Comp, ::std::less<>> ||
+                       ::std::same_as<Comp, ::std::less<T>>))
+        {
+            if (!::std::is_constant_evaluated())
+            {
+                simd_detail::minmax(bucket.data(), bucket.data() + bucket.size(), min, max);
+                continue;
+            }
+        }
+        for (auto const &e : bucket)
+        {
+            if (comp(e, min))
+            {
+                min = e;
+            }
+            if (!comp(e, max))
+            {
+                max = e;
+            }
+        }
+    }
+    return {::std::move(min), ::std::move(max)};
+}
+
+// 返回init加上a[i] * b[i]的和，a和b的大小必须相同，块布局可以不同
+// 两个deque同时按桶推进，每段连续的重叠部分在算术类型上使用向量化的乘加
+BIZWEN_EXPORT template <typename T, typename A1, typename A2>
+inline constexpr T dot(deque<T, A1> const &a, deque<T, A2> const &b, T init = T())
+{
+    assert(a.size() == b.size());
+    auto const size = static_cast<::std::size_t>(a.size());
+    deque_detail::for_each_segment(a, b, size, [&init](::std::span<T const> const x, ::std::span<T const> const y) {
+        if constexpr (simd_detail::vectorizable<T>)
+        {
+            if (!::std::is_constant_evaluated())
+            {
+                init += simd_detail::dot(x.data(), x.data() + x.size(), y.data());
+                return true;
+            }
+        }
+        for (auto i = ::std::size_t(0); i != x.size(); ++i)
+        {
+            init = ::std::move(init) + x[i] * y[i];
+        }
+        return true;
+    });
+    return init;
+}
+
+// 成对求和，结果与块布局、指令集和push_front/push_back的历史无关
+// 代价是比reduce慢，但误差界更小
+BIZWEN_EXPORT template <typename T, typename Alloc>
+inline constexpr T pairwise_sum(deque<T, Alloc> const &d)
+{
+    algorithm_detail::pairwise_accumulator<T> acc;
+    for (auto const bucket : d.buckets())
+    {
+        acc.feed(bucket.size(), [p = bucket.data()](::std::size_t const i) { return p[i]; });
+    }
+    return acc.result();
+}
+
+// a[i] * b[i]的成对求和，a和b的大小必须相同
+BIZWEN_EXPORT template <typename T, typename A1, typename A2>
+inline constexpr T pairwise_dot(deque<T, A1> const &a, deque<T, A2> const &b)
+{
+    assert(a.size() == b.size());
+    algorithm_detail::pairwise_accumulator<T> acc;
+    auto const size = static_cast<::std::size_t>(a.size());
+    deque_detail::for_each_segment(a, b, size, [&acc](::std::span<T const> const x, ::std::span<T const> const y) {
+        acc.feed(x.size(), [p = x.data(), q = y.data()](::std::size_t const i) { return p[i] * q[i]; });
+        return true;
+    });
+    return acc.result();
+}
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
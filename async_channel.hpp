@@ -0,0 +1,721 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_ASYNC_CHANNEL_HPP)
+#define BIZWEN_ASYNC_CHANNEL_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// deque
+#include "./deque.hpp"
+// assert
+#include <cassert>
+// size_t
+#include <cstddef>
+// min
+#include <algorithm>
+// invocable
+#include <concepts>
+// coroutine_handle
+#include <coroutine>
+// numeric_limits
+#include <limits>
+// allocator
+#include <memory>
+// optional
+#include <optional>
+// span
+#include <span>
+// is_nothrow_move_constructible/is_same
+#include <type_traits>
+// move/exchange
+#include <utility>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+// 直接在当前线程恢复协程
+BIZWEN_EXPORT struct inline_executor
+{
+    void operator()(::std::coroutine_handle<> const handle) const
+    {
+        handle.resume();
+    }
+};
+
+// 基于deque的协程通道
+// 不是线程安全的，所有操作和恢复都必须发生在同一个线程（或strand）上
+// 等待者是co_await表达式中的awaiter，以侵入式链表相连，因此等待不分配内存
+// 挂起的协程被销毁时，awaiter的析构函数把它从等待列表中移除，并归还尚未交给batch的pop_some租借
+// capacity为0时是同步通道，push和pop直接交接
+// Executor用于恢复被唤醒的协程，需要能以coroutine_handle<>调用
+// 唤醒不在改变状态的过程中进行：最外层的操作先完成所有状态改变，再在自己的栈上依次恢复被唤醒的协程，
+// 被恢复的协程再次操作通道时只把唤醒追加到同一个列表中，因此即使使用inline_executor，交替收发的协程也不会无限递归
+BIZWEN_EXPORT template <typename T, ::std::invocable<::std::coroutine_handle<>> Executor = inline_executor,
+                        typename Alloc = ::std::allocator<T>>
+class async_channel
+{
+    struct ready_list_;
+
+    // 已被唤醒、尚未恢复的协程，list_指向所在的列表
+    struct ready_link_
+    {
+        ready_link_ *next_{};
+        ::std::coroutine_handle<> handle_{};
+        ready_list_ *list_{};
+    };
+
+    // pop和pop_some共用的等待节点，max_为0表示pop
+    struct pop_node_
+    {
+        async_channel *ch_{};
+        ::std::size_t max_{};
+        pop_node_ *next_{};
+        ::std::coroutine_handle<> handle_{};
+        ::std::optional<T> value_{};
+        bool leased_{};
+        ready_link_ ready_{};
+    };
+
+    struct push_node_
+    {
+        async_channel *ch_{};
+        T value_;
+        push_node_ *next_{};
+        ::std::coroutine_handle<> handle_{};
+        bool ok_{};
+        ready_link_ ready_{};
+    };
+
+    // 位于最外层操作的栈上，通道在恢复期间被销毁时保存执行器的副本
+    struct ready_list_
+    {
+        async_channel *ch_{};
+        ready_link_ *head_{};
+        ready_link_ *tail_{};
+        ::std::optional<Executor> executor_{};
+    };
+
+    // 最外层的操作拥有ready_list_，在析构时恢复收集到的协程，嵌套的操作只向其中追加
+    class wake_scope_
+    {
+        ready_list_ list_;
+        bool owner_;
+
+      public:
+        explicit wake_scope_(async_channel &ch) noexcept : list_{&ch}, owner_(ch.ready_ == nullptr)
+        {
+            if (owner_)
+            {
+                ch.ready_ = &list_;
+            }
+        }
+
+        wake_scope_(wake_scope_ const &) = delete;
+
+        wake_scope_ &operator=(wake_scope_ const &) = delete;
+
+        ~wake_scope_()
+        {
+            if (!owner_)
+            {
+                return;
+            }
+            while (list_.head_ != nullptr)
+            {
+                // 恢复之后节点可能已经不存在了
+                auto const link = dequeue_(list_.head_, list_.tail_);
+                auto const handle = ::std::exchange(link->handle_, nullptr);
+                link->list_ = nullptr;
+                // 被恢复的协程可能销毁通道，因此每次都重新检查
+                if (list_.ch_ != nullptr)
+                {
+                    list_.ch_->executor_(handle);
+                }
+                else
+                {
+                    (*list_.executor_)(handle);
+                }
+            }
+            if (list_.ch_ != nullptr)
+            {
+                list_.ch_->ready_ = nullptr;
+            }
+        }
+    };
+
+    deque<T, Alloc> deque_;
+    ::std::size_t capacity_{};
+#if __has_cpp_attribute(msvc::no_unique_address)
+    [[msvc::no_unique_address]] Executor executor_{};
+#else
+    [[no_unique_address]] Executor executor_{};
+#endif
+    pop_node_ *pop_head_{};
+    pop_node_ *pop_tail_{};
+    push_node_ *push_head_{};
+    push_node_ *push_tail_{};
+    // 正在恢复被唤醒协程的最外层操作的列表
+    ready_list_ *ready_{};
+    // pop_some借出的首部元素个数，借出期间其他消费者等待
+    ::std::size_t leased_{};
+    bool lease_active_{};
+    bool closed_{};
+
+    template <typename Node>
+    static constexpr void enqueue_(Node *&head, Node *&tail, Node *const node) noexcept
+    {
+        node->next_ = nullptr;
+        if (tail == nullptr)
+        {
+            head = node;
+        }
+        else
+        {
+            tail->next_ = node;
+        }
+        tail = node;
+    }
+
+    template <typename Node>
+    static constexpr Node *dequeue_(Node *&head, Node *&tail) noexcept
+    {
+        auto const node = head;
+        head = node->next_;
+        if (head == nullptr)
+        {
+            tail = nullptr;
+        }
+        node->next_ = nullptr;
+        return node;
+    }
+
+    template <typename Node>
+    static constexpr void unlink_(Node *&head, Node *&tail, Node *const node) noexcept
+    {
+        Node *previous{};
+        for (auto p = head; p != node; p = p->next_)
+        {
+            assert(p != nullptr);
+            previous = p;
+        }
+        (previous == nullptr ? head : previous->next_) = node->next_;
+        if (tail == node)
+        {
+            tail = previous;
+        }
+        node->next_ = nullptr;
+    }
+
+    // 只记录，由最外层的wake_scope_恢复；handle_为空表示节点不在等待列表中
+    template <typename Node>
+    void wake_(Node *const node) noexcept
+    {
+        assert(ready_ != nullptr);
+        node->ready_.handle_ = ::std::exchange(node->handle_, nullptr);
+        node->ready_.list_ = ready_;
+        enqueue_(ready_->head_, ready_->tail_, &node->ready_);
+    }
+
+    // 等待者的协程在恢复之前被销毁时，从等待列表或者唤醒列表中移除节点
+    // 只在唤醒列表中时通道可能已经被销毁，因此不通过通道访问唤醒列表
+    template <typename Node>
+    static void cancel_(Node &node) noexcept
+    {
+        if (node.handle_ != nullptr)
+        {
+            auto const ch = node.ch_;
+            if constexpr (::std::is_same_v<Node, pop_node_>)
+            {
+                unlink_(ch->pop_head_, ch->pop_tail_, &node);
+            }
+            else
+            {
+                unlink_(ch->push_head_, ch->push_tail_, &node);
+            }
+            node.handle_ = nullptr;
+        }
+        if (auto const list = node.ready_.list_)
+        {
+            unlink_(list->head_, list->tail_, &node.ready_);
+            node.ready_.handle_ = nullptr;
+            node.ready_.list_ = nullptr;
+        }
+    }
+
+    // 把首部元素交给等待者，pop取走元素，pop_some获得租借
+    void grant_front_(pop_node_ &node)
+    {
+        if (node.max_ == ::std::size_t(0))
+        {
+            node.value_.emplace(::std::move(deque_.front())); // may throw
+            deque_.pop_front();
+        }
+        else
+        {
+            node.leased_ = true;
+            lease_active_ = true;
+        }
+    }
+
+    // 同步通道中从生产者直接交接元素
+    void grant_from_(pop_node_ &node, push_node_ &producer)
+    {
+        if (node.max_ == ::std::size_t(0))
+        {
+            node.value_.emplace(::std::move(producer.value_)); // may throw
+        }
+        else
+        {
+            deque_.push_back(::std::move(producer.value_)); // may throw
+            node.leased_ = true;
+            lease_active_ = true;
+        }
+        producer.ok_ = true;
+    }
+
+    // 在状态改变后唤醒所有可以继续的等待者，调用者必须持有wake_scope_
+    void dispatch_()
+    {
+        for (;;)
+        {
+            if (!lease_active_ && pop_head_ != nullptr)
+            {
+                if (!deque_.empty())
+                {
+                    grant_front_(*pop_head_);
+                    wake_(dequeue_(pop_head_, pop_tail_));
+                    continue;
+                }
+                if (push_head_ != nullptr)
+                {
+                    grant_from_(*pop_head_, *push_head_);
+                    auto const consumer = dequeue_(pop_head_, pop_tail_);
+                    auto const producer = dequeue_(push_head_, push_tail_);
+                    wake_(producer);
+                    wake_(consumer);
+                    continue;
+                }
+                if (closed_)
+                {
+                    wake_(dequeue_(pop_head_, pop_tail_));
+                    continue;
+                }
+            }
+            if (push_head_ != nullptr && static_cast<::std::size_t>(deque_.size()) < capacity_)
+            {
+                deque_.push_back(::std::move(push_head_->value_)); // may throw
+                auto const producer = dequeue_(push_head_, push_tail_);
+                producer->ok_ = true;
+                wake_(producer);
+                continue;
+            }
+            break;
+        }
+    }
+
+    bool push_suspend_(push_node_ &node, ::std::coroutine_handle<> const handle)
+    {
+        wake_scope_ const scope{*this};
+        if (closed_)
+        {
+            return false;
+        }
+        if (!lease_active_ && pop_head_ != nullptr && deque_.empty())
+        {
+            // 有等待的消费者时队列必然为空，直接交接
+            grant_from_(*pop_head_, node);
+            wake_(dequeue_(pop_head_, pop_tail_));
+            return false;
+        }
+        if (static_cast<::std::size_t>(deque_.size()) < capacity_)
+        {
+            deque_.push_back(::std::move(node.value_)); // may throw
+            node.ok_ = true;
+            return false;
+        }
+        node.handle_ = handle;
+        enqueue_(push_head_, push_tail_, &node);
+        return true;
+    }
+
+    bool pop_suspend_(pop_node_ &node, ::std::coroutine_handle<> const handle)
+    {
+        wake_scope_ const scope{*this};
+        if (!lease_active_)
+        {
+            if (!deque_.empty())
+            {
+                grant_front_(node);
+                // 取走元素后可能有空间接收等待的生产者
+                dispatch_();
+                return false;
+            }
+            if (push_head_ != nullptr)
+            {
+                grant_from_(node, *push_head_);
+                wake_(dequeue_(push_head_, push_tail_));
+                return false;
+            }
+            if (closed_)
+            {
+                return false;
+            }
+        }
+        node.handle_ = handle;
+        enqueue_(pop_head_, pop_tail_, &node);
+        return true;
+    }
+
+    // 归还pop_some借出的元素，按块批量弹出
+    void release_(::std::size_t const count)
+    {
+        assert(lease_active_ && leased_ == count);
+        wake_scope_ const scope{*this};
+        deque_.erase(deque_.begin(), deque_.begin() + static_cast<::std::ptrdiff_t>(count));
+        leased_ = ::std::size_t(0);
+        lease_active_ = false;
+        dispatch_();
+    }
+
+  public:
+    using value_type = T;
+    using size_type = ::std::size_t;
+    using allocator_type = Alloc;
+    using executor_type = Executor;
+
+    class push_awaiter
+    {
+        friend async_channel;
+
+        push_node_ node_;
+
+        template <typename U>
+        constexpr push_awaiter(async_channel &ch, U &&value) : node_{&ch, ::std::forward<U>(value)}
+        {
+        }
+
+      public:
+        push_awaiter(push_awaiter const &) = delete;
+
+        push_awaiter &operator=(push_awaiter const &) = delete;
+
+        // 协程在等待时被销毁，值被丢弃
+        ~push_awaiter()
+        {
+            cancel_(node_);
+        }
+
+        constexpr bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(::std::coroutine_handle<> const handle)
+        {
+            return node_.ch_->push_suspend_(node_, handle);
+        }
+
+        // 通道关闭时返回false，此时值被丢弃
+        constexpr bool await_resume() const noexcept
+        {
+            return node_.ok_;
+        }
+    };
+
+    class pop_awaiter
+    {
+        friend async_channel;
+
+        pop_node_ node_;
+
+        explicit constexpr pop_awaiter(async_channel &ch) noexcept : node_{&ch}
+        {
+        }
+
+      public:
+        pop_awaiter(pop_awaiter const &) = delete;
+
+        pop_awaiter &operator=(pop_awaiter const &) = delete;
+
+        // 协程在等待时被销毁，已经取出的元素随节点析构
+        ~pop_awaiter()
+        {
+            cancel_(node_);
+        }
+
+        constexpr bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(::std::coroutine_handle<> const handle)
+        {
+            return node_.ch_->pop_suspend_(node_, handle);
+        }
+
+        // 通道关闭且为空时返回nullopt
+        constexpr ::std::optional<T> await_resume() noexcept(::std::is_nothrow_move_constructible_v<T>)
+        {
+            return ::std::move(node_.value_);
+        }
+    };
+
+    // pop_some的结果，直接引用首块中的元素
+    // 析构或release时从通道中移除这些元素，在此之前其他消费者等待
+    class batch
+    {
+        friend async_channel;
+
+        async_channel *ch_{};
+        ::std::span<T> span_{};
+
+        constexpr batch(async_channel *const ch, ::std::span<T> const span) noexcept : ch_(ch), span_(span)
+        {
+        }
+
+      public:
+        constexpr batch() noexcept = default;
+
+        constexpr batch(batch &&other) noexcept
+            : ch_(::std::exchange(other.ch_, nullptr)), span_(::std::exchange(other.span_, {}))
+        {
+        }
+
+        constexpr batch &operator=(batch &&other) noexcept
+        {
+            if (this != ::std::addressof(other))
+            {
+                release();
+                ch_ = ::std::exchange(other.ch_, nullptr);
+                span_ = ::std::exchange(other.span_, {});
+            }
+            return *this;
+        }
+
+        ~batch()
+        {
+            release();
+        }
+
+        void release()
+        {
+            if (ch_ != nullptr)
+            {
+                ::std::exchange(ch_, nullptr)->release_(span_.size());
+                span_ = {};
+            }
+        }
+
+        constexpr ::std::span<T> span() const noexcept
+        {
+            return span_;
+        }
+
+        constexpr T *begin() const noexcept
+        {
+            return span_.data();
+        }
+
+        constexpr T *end() const noexcept
+        {
+            return span_.data() + span_.size();
+        }
+
+        constexpr size_type size() const noexcept
+        {
+            return span_.size();
+        }
+
+        // 通道关闭且为空时为空
+        constexpr bool empty() const noexcept
+        {
+            return span_.empty();
+        }
+    };
+
+    class pop_some_awaiter
+    {
+        friend async_channel;
+
+        pop_node_ node_;
+
+        constexpr pop_some_awaiter(async_channel &ch, size_type const max) noexcept : node_{&ch, max}
+        {
+        }
+
+      public:
+        pop_some_awaiter(pop_some_awaiter const &) = delete;
+
+        pop_some_awaiter &operator=(pop_some_awaiter const &) = delete;
+
+        // 协程在获得租借之后、创建batch之前被销毁时归还租借
+        ~pop_some_awaiter()
+        {
+            cancel_(node_);
+            if (node_.leased_)
+            {
+                node_.ch_->release_(::std::size_t(0));
+            }
+        }
+
+        constexpr bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(::std::coroutine_handle<> const handle)
+        {
+            return node_.ch_->pop_suspend_(node_, handle);
+        }
+
+        // 恢复时才计算span，因此包含等待期间到达的元素
+        batch await_resume() noexcept
+        {
+            if (!node_.leased_)
+            {
+                return {};
+            }
+            auto const ch = node_.ch_;
+            auto const buckets = ch->deque_.buckets();
+            auto const front = buckets.front();
+            auto const span = front.first((::std::min)(node_.max_, front.size()));
+            ch->leased_ = span.size();
+            // 租借交给batch
+            node_.leased_ = false;
+            return {ch, span};
+        }
+    };
+
+    explicit async_channel(size_type const capacity, Executor executor = Executor(), Alloc const &alloc = Alloc())
+        : deque_(alloc), capacity_(capacity), executor_(::std::move(executor))
+    {
+    }
+
+    async_channel(async_channel const &) = delete;
+
+    async_channel &operator=(async_channel const &) = delete;
+
+    // 析构时不能有等待者，已被唤醒的协程之后用执行器的副本恢复
+    ~async_channel()
+    {
+        assert(pop_head_ == nullptr && push_head_ == nullptr && !lease_active_);
+        if (ready_ != nullptr)
+        {
+            ready_->executor_.emplace(::std::move(executor_));
+            ready_->ch_ = nullptr;
+        }
+    }
+
+    Alloc get_allocator() const noexcept
+    {
+        return deque_.get_allocator();
+    }
+
+    Executor get_executor() const
+    {
+        return executor_;
+    }
+
+    size_type capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    // 包括被借出的元素
+    size_type size() const noexcept
+    {
+        return static_cast<size_type>(deque_.size());
+    }
+
+    bool empty() const noexcept
+    {
+        return deque_.empty();
+    }
+
+    bool is_closed() const noexcept
+    {
+        return closed_;
+    }
+
+    // co_await ch.push(v)，通道满时挂起，关闭后结果为false
+    [[nodiscard]] push_awaiter push(T const &value)
+    {
+        return {*this, value};
+    }
+
+    [[nodiscard]] push_awaiter push(T &&value)
+    {
+        return {*this, ::std::move(value)};
+    }
+
+    // co_await ch.pop()，通道空时挂起，关闭且为空时结果为nullopt
+    [[nodiscard]] pop_awaiter pop() noexcept
+    {
+        return pop_awaiter{*this};
+    }
+
+    // co_await ch.pop_some(max)，获得首块中至多max个元素的batch
+    // 持有batch时不能在同一通道上再次pop，否则会等待自己
+    [[nodiscard]] pop_some_awaiter pop_some(size_type const max) noexcept
+    {
+        assert(max != size_type(0));
+        return {*this, max};
+    }
+
+    // 不挂起的版本，通道满或已关闭时返回false
+    bool try_push(T const &value)
+    {
+        // 同步通道只能交给正在等待的消费者
+        auto const handoff = !lease_active_ && pop_head_ != nullptr && deque_.empty();
+        if (closed_ || (static_cast<::std::size_t>(deque_.size()) >= capacity_ && !handoff))
+        {
+            return false;
+        }
+        wake_scope_ const scope{*this};
+        deque_.push_back(value); // may throw
+        dispatch_();
+        return true;
+    }
+
+    // 不挂起的版本，没有可用元素时返回nullopt
+    ::std::optional<T> try_pop()
+    {
+        if (lease_active_ || deque_.empty())
+        {
+            return ::std::nullopt;
+        }
+        wake_scope_ const scope{*this};
+        ::std::optional<T> result{::std::move(deque_.front())};
+        deque_.pop_front();
+        dispatch_();
+        return result;
+    }
+
+    // 唤醒所有等待者，等待的生产者得到false，消费者在取完剩余元素后得到空结果
+    void close()
+    {
+        wake_scope_ const scope{*this};
+        closed_ = true;
+        while (push_head_ != nullptr)
+        {
+            wake_(dequeue_(push_head_, push_tail_));
+        }
+        dispatch_();
+    }
+};
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
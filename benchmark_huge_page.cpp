@@ -0,0 +1,166 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+// compares a deque using std::allocator with one using huge_page_allocator
+// usage: benchmark_huge_page [elements] [random reads]
+// dTLB misses are read with perf_event_open when the CPU exposes them; page faults are a software counter and are
+// always available, so the benchmark also works in virtual machines and without perf privileges for hardware events
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "./deque.hpp"
+#include "./huge_page.hpp"
+
+namespace
+{
+class counter
+{
+    int fd_{-1};
+
+  public:
+    counter(std::uint32_t const type, std::uint64_t const config) noexcept
+    {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    counter(counter const &) = delete;
+
+    counter &operator=(counter const &) = delete;
+
+    ~counter()
+    {
+        if (fd_ != -1)
+        {
+            ::close(fd_);
+        }
+    }
+
+    void start() const noexcept
+    {
+        if (fd_ != -1)
+        {
+            ::ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    std::string stop() const
+    {
+        if (fd_ == -1)
+        {
+            return "n/a";
+        }
+        ::ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        std::uint64_t value{};
+        if (::read(fd_, &value, sizeof(value)) != static_cast<::ssize_t>(sizeof(value)))
+        {
+            return "n/a";
+        }
+        return std::to_string(value);
+    }
+};
+
+struct counters
+{
+    counter dtlb{PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+    counter faults{PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS};
+    std::chrono::steady_clock::time_point begin{};
+
+    void start() noexcept
+    {
+        dtlb.start();
+        faults.start();
+        begin = std::chrono::steady_clock::now();
+    }
+
+    void stop(char const *const allocator, char const *const phase)
+    {
+        auto const end = std::chrono::steady_clock::now();
+        auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+        auto const tlb = dtlb.stop();
+        auto const pf = faults.stop();
+        std::printf("%-20s %-8s %8lld ms  dTLB-load-misses %14s  page-faults %10s\n", allocator, phase,
+                    static_cast<long long>(ms), tlb.c_str(), pf.c_str());
+    }
+};
+
+std::string anon_huge_pages()
+{
+    std::ifstream smaps{"/proc/self/smaps_rollup"};
+    for (std::string line{}; std::getline(smaps, line);)
+    {
+        if (line.starts_with("AnonHugePages:"))
+        {
+            return line.substr(14u);
+        }
+    }
+    return " n/a";
+}
+
+template <typename Alloc>
+void run(char const *const allocator, std::size_t const elements, std::size_t const reads, Alloc const &alloc)
+{
+    counters c{};
+    bizwen::deque<std::uint64_t, Alloc> d(alloc);
+    c.start();
+    for (auto i = std::size_t(0); i != elements; ++i)
+    {
+        d.push_back(i);
+    }
+    c.stop(allocator, "fill");
+    c.start();
+    std::uint64_t sum{};
+    for (auto const i : d)
+    {
+        sum += i;
+    }
+    c.stop(allocator, "iterate");
+    c.start();
+    // linear congruential generator, so that the index sequence is the same for both allocators
+    std::uint64_t x{1u};
+    for (auto i = std::size_t(0); i != reads; ++i)
+    {
+        x = x * 6364136223846793005u + 1442695040888963407u;
+        sum += d[static_cast<std::size_t>((x >> 16) % elements)];
+    }
+    c.stop(allocator, "random");
+    std::printf("%-20s AnonHugePages:%s, checksum %llu\n", allocator, anon_huge_pages().c_str(),
+                static_cast<unsigned long long>(sum));
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    auto const elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1ull << 27;
+    auto const reads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1ull << 25;
+    {
+        std::ifstream thp{"/sys/kernel/mm/transparent_hugepage/enabled"};
+        std::string mode{};
+        std::getline(thp, mode);
+        std::printf("transparent_hugepage: %s\n", mode.empty() ? "unavailable" : mode.c_str());
+    }
+    run("std::allocator", elements, reads, std::allocator<std::uint64_t>{});
+    bizwen::huge_page_resource resource{};
+    run("huge_page_allocator", elements, reads, bizwen::huge_page_allocator<std::uint64_t>{&resource});
+}
@@ -0,0 +1,323 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_CONCURRENT_QUEUE_HPP)
+#define BIZWEN_CONCURRENT_QUEUE_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// deque
+#include "./deque.hpp"
+// size_t
+#include <cstddef>
+// min/ranges::move
+#include <algorithm>
+// condition_variable
+#include <condition_variable>
+// output_iterator
+#include <iterator>
+// numeric_limits
+#include <limits>
+// allocator
+#include <memory>
+// mutex/unique_lock/lock_guard
+#include <mutex>
+// optional
+#include <optional>
+// ranges::forward_range/subrange/next
+#include <ranges>
+// move/forward
+#include <utility>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+// 多生产者多消费者阻塞队列
+// deque的reserve_back_可能移动控制块中的全部块指针，因此首尾不能使用两把锁，
+// 这里使用一把锁并通过批量操作使一次加锁处理多个元素
+// capacity为最大元素个数，默认无上限；close后push失败，pop在队列为空后失败
+BIZWEN_EXPORT template <typename T, typename Alloc = ::std::allocator<T>>
+class concurrent_queue
+{
+    mutable ::std::mutex mutex_{};
+    ::std::condition_variable not_empty_{};
+    ::std::condition_variable not_full_{};
+    deque<T, Alloc> deque_;
+    ::std::size_t capacity_{};
+    bool closed_{};
+
+    bool full_() const noexcept
+    {
+        return static_cast<::std::size_t>(deque_.size()) >= capacity_;
+    }
+
+    // 需要持有锁且队列非空
+    template <typename U>
+    ::std::size_t pop_n_locked_(U &out, ::std::size_t const max)
+    {
+        auto const count = (::std::min)(max, static_cast<::std::size_t>(deque_.size()));
+        auto remain = count;
+        for (auto const bucket : deque_.buckets())
+        {
+            if (remain == ::std::size_t(0))
+            {
+                break;
+            }
+            auto const n = (::std::min)(remain, bucket.size());
+            out = ::std::ranges::move(bucket.first(n), ::std::move(out)).out;
+            remain -= n;
+        }
+        // 从首部erase即按块批量弹出
+        deque_.erase(deque_.begin(), deque_.begin() + static_cast<::std::ptrdiff_t>(count));
+        return count;
+    }
+
+    template <typename... V>
+    void emplace_locked_(V &&...v)
+    {
+        deque_.emplace_back(::std::forward<V>(v)...);
+        not_empty_.notify_one();
+    }
+
+    // 需要持有锁，最多放入剩余容量个元素
+    template <typename U, typename S>
+    U push_range_locked_(U first, S const last)
+    {
+        using diff_t = ::std::iter_difference_t<U>;
+        auto const space = (::std::min)(capacity_ - static_cast<::std::size_t>(deque_.size()),
+                                        static_cast<::std::size_t>((::std::numeric_limits<diff_t>::max)()));
+        auto const mid = ::std::ranges::next(first, static_cast<diff_t>(space), last);
+        if (first != mid)
+        {
+            // 随机访问范围只调用一次reserve_back_
+            deque_.append_range(::std::ranges::subrange(first, mid));
+            not_empty_.notify_all();
+        }
+        return mid;
+    }
+
+  public:
+    using value_type = T;
+    using size_type = ::std::size_t;
+    using allocator_type = Alloc;
+
+    concurrent_queue()
+        requires ::std::default_initializable<Alloc>
+        : concurrent_queue((::std::numeric_limits<size_type>::max)())
+    {
+    }
+
+    explicit concurrent_queue(size_type const capacity, Alloc const &alloc = Alloc())
+        : deque_(alloc), capacity_(capacity)
+    {
+    }
+
+    concurrent_queue(concurrent_queue const &) = delete;
+
+    concurrent_queue &operator=(concurrent_queue const &) = delete;
+
+    Alloc get_allocator() const noexcept
+    {
+        return deque_.get_allocator();
+    }
+
+    size_type capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    size_type size() const
+    {
+        ::std::lock_guard lock(mutex_);
+        return static_cast<size_type>(deque_.size());
+    }
+
+    bool empty() const
+    {
+        ::std::lock_guard lock(mutex_);
+        return deque_.empty();
+    }
+
+    // 唤醒所有等待的线程，之后push总是失败，pop在取完剩余元素后失败
+    void close()
+    {
+        {
+            ::std::lock_guard lock(mutex_);
+            closed_ = true;
+        }
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+    bool is_closed() const
+    {
+        ::std::lock_guard lock(mutex_);
+        return closed_;
+    }
+
+    // 队列满时阻塞，关闭后返回false
+    template <typename... V>
+    bool emplace(V &&...v)
+    {
+        ::std::unique_lock lock(mutex_);
+        not_full_.wait(lock, [this] { return closed_ || !full_(); });
+        if (closed_)
+        {
+            return false;
+        }
+        emplace_locked_(::std::forward<V>(v)...);
+        return true;
+    }
+
+    bool push(T const &value)
+    {
+        return emplace(value);
+    }
+
+    bool push(T &&value)
+    {
+        return emplace(::std::move(value));
+    }
+
+    // 队列满或已关闭时返回false
+    template <typename... V>
+    bool try_emplace(V &&...v)
+    {
+        ::std::lock_guard lock(mutex_);
+        if (closed_ || full_())
+        {
+            return false;
+        }
+        emplace_locked_(::std::forward<V>(v)...);
+        return true;
+    }
+
+    bool try_push(T const &value)
+    {
+        return try_emplace(value);
+    }
+
+    bool try_push(T &&value)
+    {
+        return try_emplace(::std::move(value));
+    }
+
+    // 每次获得锁时放入尽可能多的元素，队列满时阻塞
+    // 返回放入的元素个数，只有关闭时才会小于范围的大小
+    template <::std::ranges::forward_range R>
+        requires ::std::convertible_to<::std::ranges::range_reference_t<R>, T>
+    size_type push_range(R &&rg)
+    {
+        auto first = ::std::ranges::begin(rg);
+        auto const last = ::std::ranges::end(rg);
+        auto count = size_type(0);
+        ::std::unique_lock lock(mutex_);
+        while (first != last)
+        {
+            not_full_.wait(lock, [this] { return closed_ || !full_(); });
+            if (closed_)
+            {
+                break;
+            }
+            auto const mid = push_range_locked_(first, last);
+            count += static_cast<size_type>(::std::ranges::distance(first, mid));
+            first = mid;
+        }
+        return count;
+    }
+
+    // 只放入当前容量允许的元素，不阻塞
+    template <::std::ranges::forward_range R>
+        requires ::std::convertible_to<::std::ranges::range_reference_t<R>, T>
+    size_type try_push_range(R &&rg)
+    {
+        auto const first = ::std::ranges::begin(rg);
+        ::std::lock_guard lock(mutex_);
+        if (closed_)
+        {
+            return size_type(0);
+        }
+        auto const mid = push_range_locked_(first, ::std::ranges::end(rg));
+        return static_cast<size_type>(::std::ranges::distance(first, mid));
+    }
+
+    // 队列空时阻塞，关闭且为空时返回nullopt
+    ::std::optional<T> pop()
+    {
+        ::std::unique_lock lock(mutex_);
+        not_empty_.wait(lock, [this] { return closed_ || !deque_.empty(); });
+        if (deque_.empty())
+        {
+            return ::std::nullopt;
+        }
+        ::std::optional<T> result{::std::move(deque_.front())};
+        deque_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+        return result;
+    }
+
+    ::std::optional<T> try_pop()
+    {
+        ::std::unique_lock lock(mutex_);
+        if (deque_.empty())
+        {
+            return ::std::nullopt;
+        }
+        ::std::optional<T> result{::std::move(deque_.front())};
+        deque_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+        return result;
+    }
+
+    // 队列空时阻塞，之后一次取出至多max个元素写入out
+    // 返回取出的元素个数，max不为0时只有关闭且为空时返回0；max为0时不等待，直接返回0
+    template <::std::output_iterator<T &&> O>
+    size_type pop_n(O out, size_type const max)
+    {
+        if (max == size_type(0))
+        {
+            return size_type(0);
+        }
+        ::std::unique_lock lock(mutex_);
+        not_empty_.wait(lock, [this] { return closed_ || !deque_.empty(); });
+        if (deque_.empty())
+        {
+            return size_type(0);
+        }
+        auto const count = pop_n_locked_(out, max);
+        lock.unlock();
+        not_full_.notify_all();
+        return count;
+    }
+
+    template <::std::output_iterator<T &&> O>
+    size_type try_pop_n(O out, size_type const max)
+    {
+        ::std::unique_lock lock(mutex_);
+        if (deque_.empty() || max == size_type(0))
+        {
+            return size_type(0);
+        }
+        auto const count = pop_n_locked_(out, max);
+        lock.unlock();
+        not_full_.notify_all();
+        return count;
+    }
+};
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
@@ -1,5 +1,27 @@
 module;
 #include <cassert>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+#if __has_include(<sys/mman.h>)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+#if __has_include(<sys/uio.h>)
+#include <cerrno>
+#include <climits>
+#include <sys/uio.h>
+#endif
 
 export module bizwen.deque;
 
@@ -8,3 +30,22 @@ import std;
 #define BIZWEN_MODULE
 
 #include "./deque.hpp"
+#include "./ws_deque.hpp"
+#include "./spsc_deque.hpp"
+#include "./concurrent_queue.hpp"
+#include "./async_channel.hpp"
+#include "./algorithm.hpp"
+#include "./parallel.hpp"
+#include "./dynamic_buffer.hpp"
+#include "./records.hpp"
+#include "./serialize.hpp"
+#include "./offset_ptr.hpp"
+#if __has_include(<sys/mman.h>)
+#include "./vm_deque.hpp"
+#include "./mapped_deque.hpp"
+#include "./huge_page.hpp"
+#endif
+#if defined(__linux__)
+#include "./magic_ring.hpp"
+#include "./shared_deque.hpp"
+#endif
@@ -13,9 +13,17 @@
 
 // assert
 #include <cassert>
-// ptrdiff_t/size_t
+// ptrdiff_t/size_t/byte
 #include <cstddef>
-// ranges::copy/copy_back_ward/rotate/move/move_backward/remove/remove_if
+// uint64_t
+#include <cstdint>
+// memcmp/memcpy
+#include <cstring>
+// rotl
+#include <bit>
+// hash/equal_to
+#include <functional>
+// ranges::copy/copy_back_ward/rotate/move/move_backward/equal/mismatch/min
 #include <algorithm>
 // strong_ordering/lexicographical_compare/lexicographical_compare_three_way
 #include <compare>
@@ -37,6 +45,10 @@
 #include <version>
 // polymorphic_allocator
 #include <memory_resource>
+#if defined(__cpp_lib_execution)
+// is_execution_policy
+#include <execution>
+#endif
 
 #if defined(__cpp_exceptions)
 // out_of_range
@@ -67,6 +79,18 @@ namespace bizwen
 BIZWEN_EXPORT template <typename T, typename Alloc>
 class deque;
 
+BIZWEN_EXPORT template <typename T, typename Alloc>
+    requires(sizeof(T) == 1 && ::std::is_trivially_copyable_v<T>)
+class dynamic_buffer;
+
+BIZWEN_EXPORT template <typename T>
+    requires ::std::is_trivially_copyable_v<T>
+class mapped_deque;
+
+BIZWEN_EXPORT template <typename T>
+    requires ::std::is_trivially_copyable_v<T>
+class shared_deque;
+
 namespace deque_detail
 {
 
@@ -214,6 +238,10 @@ inline constexpr ::std::size_t block_elements_v = ::std::size_t(16) > ::std::siz
                                                       : ::std::size_t(4096) / sizeof(T);
 #endif
 
+// 并发容器用于隔离原子变量以避免伪共享
+// 不使用hardware_destructive_interference_size，因为它会导致ABI随编译选项变化
+inline constexpr ::std::size_t cache_line_size_v = ::std::size_t(64);
+
 // 构造函数和赋值用，计算如何分配和构造
 template <typename T>
 inline constexpr auto calc_cap(::std::size_t const size) noexcept
@@ -278,6 +306,7 @@ class bucket_iterator
     friend buckets_type<deque_detail::add_adl_firewall_t<RConstT>, FirewallBlock, DiffType>;
     friend buckets_type<deque_detail::add_adl_firewall_t<T>, FirewallBlock, DiffType>;
     friend bucket_iterator<deque_detail::add_adl_firewall_t<T const>, FirewallBlock, DiffType>;
+    friend bucket_iterator<deque_detail::add_adl_firewall_t<RConstT>, FirewallBlock, DiffType>;
 
     Block *block_elem_begin_{};
     Block *block_elem_end_{};
@@ -307,25 +336,37 @@ class bucket_iterator
                 elem_end_begin_,   elem_end_end_,   elem_curr_begin_, elem_curr_end_};
     }
 
-    constexpr bucket_iterator &plus_and_assign_(::std::ptrdiff_t const pos) noexcept
+    // 根据block_elem_curr_重新计算当前块的span，尾后位置为空span
+    constexpr void update_curr_() noexcept
     {
-        block_elem_curr_ += pos;
-        if (block_elem_curr_ + ::std::size_t(1) == block_elem_end_)
+        assert(block_elem_curr_ <= block_elem_end_ && block_elem_curr_ >= block_elem_begin_);
+        if (block_elem_curr_ == block_elem_end_)
         {
-            elem_curr_begin_ = elem_end_begin_;
-            elem_curr_end_ = elem_end_end_;
+            elem_curr_begin_ = nullptr;
+            elem_curr_end_ = nullptr;
         }
         else if (block_elem_curr_ == block_elem_begin_)
         {
+            // 只有一个块时首尾span相同
             elem_curr_begin_ = elem_begin_begin_;
             elem_curr_end_ = elem_begin_end_;
         }
+        else if (block_elem_curr_ + ::std::size_t(1) == block_elem_end_)
+        {
+            elem_curr_begin_ = elem_end_begin_;
+            elem_curr_end_ = elem_end_end_;
+        }
         else
         {
-            elem_curr_begin_ = *block_elem_begin_;
-            elem_curr_end_ = elem_begin_begin_ + block_elements_v<T>;
+            elem_curr_begin_ = ::std::to_address(*block_elem_curr_);
+            elem_curr_end_ = elem_curr_begin_ + block_elements_v<T>;
         }
-        assert(block_elem_curr_ < block_elem_end_ && block_elem_curr_ >= block_elem_begin_);
+    }
+
+    constexpr bucket_iterator &plus_and_assign_(::std::ptrdiff_t const pos) noexcept
+    {
+        block_elem_curr_ += pos;
+        update_curr_();
         return *this;
     }
 
@@ -346,18 +387,9 @@ class bucket_iterator
 
     constexpr bucket_iterator &operator++() noexcept
     {
-        ++block_elem_curr_;
-        if (block_elem_curr_ + ::std::size_t(1) == block_elem_end_)
-        {
-            elem_curr_begin_ = elem_end_begin_;
-            elem_curr_end_ = elem_end_end_;
-        }
-        else
-        {
-            elem_curr_begin_ = *block_elem_begin_;
-            elem_curr_end_ = elem_begin_begin_ + block_elements_v<T>;
-        }
         assert(block_elem_curr_ < block_elem_end_);
+        ++block_elem_curr_;
+        update_curr_();
         return *this;
     }
 
@@ -374,18 +406,9 @@ class bucket_iterator
 
     constexpr bucket_iterator &operator--() noexcept
     {
+        assert(block_elem_curr_ > block_elem_begin_);
         --block_elem_curr_;
-        if (block_elem_curr_ == block_elem_begin_)
-        {
-            elem_curr_begin_ = elem_begin_begin_;
-            elem_curr_end_ = elem_begin_end_;
-        }
-        else
-        {
-            elem_begin_begin_ = *(block_elem_begin_ - ::std::size_t(1));
-            elem_begin_end_ = elem_begin_begin_ + block_elements_v<T>;
-        }
-        assert(block_elem_curr_ >= block_elem_begin_);
+        update_curr_();
         return *this;
     }
 
@@ -536,7 +559,7 @@ class buckets_type : public ::std::ranges::view_interface<buckets_type<FirewallT
 
     constexpr ::std::span<T> at_impl(::std::size_t const pos) const noexcept
     {
-        assert(block_elem_begin_ + pos <= block_elem_end_);
+        assert(block_elem_begin_ + pos < block_elem_end_);
         if (pos == ::std::size_t(0))
         {
             return {elem_begin_begin_, elem_begin_end_};
@@ -628,17 +651,8 @@ class buckets_type : public ::std::ranges::view_interface<buckets_type<FirewallT
 
     constexpr const_iterator end() const noexcept
     {
-        if (block_elem_begin_ == block_elem_end_)
-        {
-            return {block_elem_begin_, block_elem_end_, block_elem_end_, elem_begin_begin_, elem_begin_end_,
-                    elem_end_begin_,   elem_end_end_,   elem_end_begin_, elem_end_end_};
-        }
-        else
-        {
-            return {block_elem_begin_, block_elem_end_, block_elem_end_ - ::std::size_t(1),
-                    elem_begin_begin_, elem_begin_end_, elem_end_begin_,
-                    elem_end_end_,     elem_end_begin_, elem_end_end_};
-        }
+        return {block_elem_begin_, block_elem_end_, block_elem_end_, elem_begin_begin_, elem_begin_end_,
+                elem_end_begin_,   elem_end_end_,   nullptr,         nullptr};
     }
 
     constexpr iterator begin() noexcept
@@ -732,7 +746,7 @@ class deque_iterator
         }
         assert(elem_curr_ >= elem_begin_);
         assert(elem_curr_ <= elem_begin_ + block_elements_v<T>);
-        if (block_elem_curr_ == buckets_.block_elem_end_ - ::std::size_t(1))
+        if (block_elem_curr_ != nullptr && block_elem_curr_ == buckets_.block_elem_end_ - ::std::size_t(1))
         {
             assert(elem_curr_ <= buckets_.elem_end_end_);
         }
@@ -1100,6 +1114,122 @@ class repeat_iterator
 static_assert(::std::random_access_iterator<repeat_iterator<int>>);
 #endif
 #endif
+
+// 同时遍历两个deque的前n个元素，两者的块布局可以不同
+// 每次以两个等长的连续段调用f，f返回false时停止并返回false
+template <typename A, typename B, typename F>
+inline constexpr bool for_each_segment(A &a, B &b, ::std::size_t n, F &&f)
+{
+    auto a_buckets = a.buckets();
+    auto b_buckets = b.buckets();
+    auto a_index = ::std::size_t(0);
+    auto b_index = ::std::size_t(0);
+    decltype(a_buckets.at(0)) x{};
+    decltype(b_buckets.at(0)) y{};
+    while (n != ::std::size_t(0))
+    {
+        if (x.empty())
+        {
+            x = a_buckets.at(a_index++);
+        }
+        if (y.empty())
+        {
+            y = b_buckets.at(b_index++);
+        }
+        auto const m = (::std::min)({x.size(), y.size(), n});
+        if (!f(x.first(m), y.first(m)))
+        {
+            return false;
+        }
+        x = x.subspan(m);
+        y = y.subspan(m);
+        n -= m;
+    }
+    return true;
+}
+
+// 值相等当且仅当对象表示相同的类型，可以用memcmp判断相等
+template <typename T>
+concept memcmp_equality = ::std::is_integral_v<T> || ::std::is_pointer_v<T> || ::std::is_same_v<T, ::std::byte>;
+
+// memcmp的结果与字典序相同的类型
+template <typename T>
+concept memcmp_ordering =
+    sizeof(T) == 1 && (::std::is_same_v<T, ::std::byte> || (::std::is_integral_v<T> && ::std::is_unsigned_v<T>));
+
+// 具有唯一对象表示的可平凡复制类型，值相同时字节也相同，因此可以按字节哈希
+template <typename T>
+concept byte_hashable = ::std::is_trivially_copyable_v<T> && ::std::has_unique_object_representations_v<T>;
+
+// 流式的字节哈希，结果只取决于输入的字节序列，与分几次输入无关
+// 每8个字节组成一个字，按MurmurHash3的方式混合，不足一个字的字节暂存到下次输入
+class byte_hasher
+{
+    ::std::uint64_t hash_{0x9E3779B97F4A7C15u};
+    ::std::uint64_t size_{};
+    unsigned char buffer_[8]{};
+
+    static ::std::uint64_t mix_(::std::uint64_t word) noexcept
+    {
+        word *= 0x87C37B91114253D5u;
+        word = ::std::rotl(word, 31);
+        return word * 0x4CF5AD432745937Fu;
+    }
+
+    void word_(unsigned char const *const p) noexcept
+    {
+        auto word = ::std::uint64_t(0);
+        ::std::memcpy(&word, p, sizeof(word));
+        hash_ ^= mix_(word);
+        hash_ = ::std::rotl(hash_, 27) * 5u + 0x52DCE729u;
+    }
+
+  public:
+    void update(void const *const data, ::std::size_t n) noexcept
+    {
+        auto p = static_cast<unsigned char const *>(data);
+        auto const used = static_cast<::std::size_t>(size_ % sizeof(buffer_));
+        size_ += n;
+        if (used != ::std::size_t(0))
+        {
+            auto const m = (::std::min)(sizeof(buffer_) - used, n);
+            ::std::memcpy(buffer_ + used, p, m);
+            if (used + m != sizeof(buffer_))
+            {
+                return;
+            }
+            word_(buffer_);
+            p += m;
+            n -= m;
+        }
+        for (; n >= sizeof(buffer_); p += sizeof(buffer_), n -= sizeof(buffer_))
+        {
+            word_(p);
+        }
+        if (n != ::std::size_t(0))
+        {
+            ::std::memcpy(buffer_, p, n);
+        }
+    }
+
+    ::std::size_t finish() const noexcept
+    {
+        auto hash = hash_;
+        if (auto const used = static_cast<::std::size_t>(size_ % sizeof(buffer_)); used != ::std::size_t(0))
+        {
+            auto word = ::std::uint64_t(0);
+            ::std::memcpy(&word, buffer_, used);
+            hash ^= mix_(word);
+        }
+        hash ^= size_;
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDu;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53u;
+        hash ^= hash >> 33;
+        return static_cast<::std::size_t>(hash);
+    }
+};
 } // namespace deque_detail
 
 template <typename T, typename Alloc = ::std::allocator<T>>
@@ -1112,7 +1242,10 @@ class deque
 #endif
     using atraits_t_ = ::std::allocator_traits<Alloc>;
 
-    static constexpr bool is_default_operation_ = requires(Alloc &a) { a.construct(static_cast<T *>(nullptr)); };
+    // 分配器没有自定义construct和destroy
+    static constexpr bool is_default_operation_ =
+        !requires(Alloc &a) { a.construct(static_cast<T *>(nullptr)); } &&
+        !requires(Alloc &a) { a.destroy(static_cast<T *>(nullptr)); };
     static constexpr bool is_aleq_ = atraits_t_::is_always_equal::value;
     static constexpr bool is_pocca_ = atraits_t_::propagate_on_container_copy_assignment::value;
     static constexpr bool is_pocma_ = atraits_t_::propagate_on_container_move_assignment::value;
@@ -1693,19 +1826,80 @@ class deque
         }
         else
         {
-            // 否则扩展控制块
-            ctrl_alloc_ const ctrl{*this, block_alloc_size_() + add_block_size}; // may throw
+            // 否则扩展控制块，至少翻倍，使得逐个添加元素时复制控制块的总开销是线性的
+            auto const alloc_size = block_alloc_size_();
+            auto const ctrl_size = (::std::max)(alloc_size + add_block_size, alloc_size * ::std::size_t(2));
+            ctrl_alloc_ const ctrl{*this, ctrl_size}; // may throw
             ctrl.replace_ctrl_back();
         }
         extent_block_back_uncond_(add_block_size);
     }
 
+    // 尾部没有空闲块时，把头部的一个空闲块移到已分配块之后，不移动其他块也不分配内存
+    // 这使得先进先出的使用方式中块在控制块上像环一样滑动，而不是每用完一个块就调用reserve_back_旋转所有块
+    // 已分配块到达控制块末尾时整体移回控制块开头，控制块的余量不足已分配块数时扩展一次控制块，
+    // 使得每次整体移动之后至少有已分配块数次O(1)的回收
+    // 头部没有空闲块或者尾部还有空闲块时返回false
+    constexpr bool recycle_block_back_()
+    {
+        if (block_alloc_begin_ == block_elem_begin_ || block_alloc_end_ != block_elem_end_)
+        {
+            return false;
+        }
+        if (block_alloc_end_ == block_ctrl_end_)
+        {
+            if (auto const alloc_size = block_alloc_size_(); block_ctrl_size_() < alloc_size * ::std::size_t(2))
+            {
+                ctrl_alloc_ const ctrl{*this, alloc_size * ::std::size_t(2)}; // may throw
+                ctrl.replace_ctrl_back();
+            }
+            else
+            {
+                align_elem_alloc_as_ctrl_back_(block_ctrl_begin_());
+            }
+            return true;
+        }
+        *block_alloc_end_ = *block_alloc_begin_;
+        ++block_alloc_end_;
+        ++block_alloc_begin_;
+        return true;
+    }
+
+    // 参考recycle_block_back_
+    constexpr bool recycle_block_front_()
+    {
+        if (block_alloc_end_ == block_elem_end_ || block_alloc_begin_ != block_elem_begin_)
+        {
+            return false;
+        }
+        if (block_alloc_begin_ == block_ctrl_begin_())
+        {
+            if (auto const alloc_size = block_alloc_size_(); block_ctrl_size_() < alloc_size * ::std::size_t(2))
+            {
+                ctrl_alloc_ const ctrl{*this, alloc_size * ::std::size_t(2)}; // may throw
+                ctrl.replace_ctrl_front();
+            }
+            else
+            {
+                align_elem_alloc_as_ctrl_front_(block_ctrl_end_);
+            }
+            return true;
+        }
+        --block_alloc_end_;
+        --block_alloc_begin_;
+        *block_alloc_begin_ = *block_alloc_end_;
+        return true;
+    }
+
     // 向back扩展
     // 对空deque安全
     constexpr void reserve_one_back_()
     {
 #if 1
-        reserve_back_(::std::size_t(1));
+        if (!recycle_block_back_())
+        {
+            reserve_back_(::std::size_t(1));
+        }
 #else
         if (block_alloc_end_ != block_elem_end_)
         {
@@ -1768,8 +1962,10 @@ class deque
         }
         else
         {
-            // 否则扩展控制块
-            ctrl_alloc_ const ctrl{*this, block_alloc_size_() + add_block_size}; // may throw
+            // 否则扩展控制块，至少翻倍，使得逐个添加元素时复制控制块的总开销是线性的
+            auto const alloc_size = block_alloc_size_();
+            auto const ctrl_size = (::std::max)(alloc_size + add_block_size, alloc_size * ::std::size_t(2));
+            ctrl_alloc_ const ctrl{*this, ctrl_size}; // may throw
             ctrl.replace_ctrl_front();
         }
         // 必须最后执行
@@ -1781,7 +1977,10 @@ class deque
     constexpr void reserve_one_front_()
     {
 #if 1
-        reserve_front_(::std::size_t(1));
+        if (!recycle_block_front_())
+        {
+            reserve_front_(::std::size_t(1));
+        }
 #else
         if (block_elem_begin_ != block_alloc_begin_)
         {
@@ -1931,6 +2130,41 @@ class deque
         }
     }
 
+#if defined(__cpp_lib_execution)
+    // 元素的复制和块之间无关，因此在分配所有块后按块并行复制
+    // 执行策略中抛出异常会调用std::terminate，因此只用于复制不抛出异常的类型
+    template <typename ExecutionPolicy>
+    void par_copy_(ExecutionPolicy &&policy, const_buckets_type const other, ::std::size_t const block_size)
+    {
+        static_assert(::std::is_nothrow_copy_constructible_v<T> && is_default_operation_);
+        auto const blocks = block_elem_end_;
+        auto const last_block = block_size - ::std::size_t(1);
+        // 与copy_相同，首块的元素放在块的末尾
+        ::std::for_each(::std::forward<ExecutionPolicy>(policy), blocks, blocks + block_size, [&](Block const &block) {
+            auto const i = static_cast<::std::size_t>(::std::addressof(block) - blocks);
+            auto const src = other.at_impl(i);
+            auto const first = ::std::to_address(block);
+            auto const begin =
+                i == ::std::size_t(0) ? first + deque_detail::block_elements_v<T> - src.size() : first;
+            deque_detail::uninitialized_copy(allocator_, src.begin(), src.end(), begin, ::std::unreachable_sentinel);
+        });
+        // 所有元素构造完毕后才设置范围，此前guard只需释放内存
+        auto const first = ::std::to_address(*blocks);
+        auto const first_last = first + deque_detail::block_elements_v<T>;
+        elem_begin_(first_last - other.at_impl(::std::size_t(0)).size(), first_last, first);
+        if (block_size == ::std::size_t(1))
+        {
+            elem_end_(elem_begin_begin_, first_last, first_last);
+        }
+        else
+        {
+            auto const begin = ::std::to_address(blocks[last_block]);
+            elem_end_(begin, begin + other.at_impl(last_block).size(), begin + deque_detail::block_elements_v<T>);
+        }
+        block_elem_end_ = blocks + block_size;
+    }
+#endif
+
   public:
     constexpr deque() noexcept(::std::is_nothrow_default_constructible_v<Alloc>)
         requires ::std::default_initializable<Alloc>
@@ -2095,6 +2329,36 @@ class deque
         }
     }
 
+    // 滑动窗口：在尾部构造元素，然后从头部移除元素直到size()不超过max_size
+    // 头部因此空出的块之后由recycle_block_back_直接移到尾部，窗口稳定之后不分配内存
+    // 先构造再移除，因此v可以引用将被移除的元素，构造抛出异常时容器不变
+    template <typename... V>
+    constexpr T &emplace_back_evict(size_type const max_size, V &&...v)
+    {
+        assert(max_size != size_type(0));
+        auto const old_size = static_cast<::std::size_t>(size());
+        auto &result = emplace_back(::std::forward<V>(v)...);
+        if (old_size == max_size)
+        {
+            pop_front();
+        }
+        else if (old_size > max_size)
+        {
+            pop_front_n_(old_size + ::std::size_t(1) - max_size);
+        }
+        return result;
+    }
+
+    constexpr void push_back_evict(size_type const max_size, T const &t)
+    {
+        emplace_back_evict(max_size, t);
+    }
+
+    constexpr void push_back_evict(size_type const max_size, T &&t)
+    {
+        emplace_back_evict(max_size, ::std::move(t));
+    }
+
     explicit deque(size_type const count, Alloc const &alloc = Alloc()) : allocator_(alloc)
     {
         assert(allocator_ == alloc);
@@ -2210,6 +2474,31 @@ class deque
         }
     }
 
+#if defined(__cpp_lib_execution)
+    // 并行复制构造，元素的复制可能抛出异常时退化为串行复制
+    template <typename ExecutionPolicy>
+        requires ::std::is_execution_policy_v<::std::remove_cvref_t<ExecutionPolicy>>
+    deque(ExecutionPolicy &&policy, deque const &other)
+        : allocator_(atraits_t_::select_on_container_copy_construction(other.allocator_))
+    {
+        if (!other.empty())
+        {
+            construct_guard_ guard(this);
+            auto const block_size = other.block_elem_size_();
+            extent_block_(block_size);
+            if constexpr (::std::is_nothrow_copy_constructible_v<T> && is_default_operation_)
+            {
+                par_copy_(::std::forward<ExecutionPolicy>(policy), other.buckets(), block_size);
+            }
+            else
+            {
+                copy_(other.buckets(), block_size);
+            }
+            guard.release();
+        }
+    }
+#endif
+
     constexpr deque(deque const &other, ::std::type_identity_t<Alloc> const &alloc) : allocator_(alloc)
     {
         assert(allocator_ == alloc);
@@ -2629,24 +2918,225 @@ class deque
     }
 
   private:
+    // 按块批量析构后一次性调整指针，不逐个调用pop_back
     constexpr void pop_back_n_(::std::size_t const count) noexcept
     {
-        for (auto i = ::std::size_t(0); i != count; ++i)
+        if (count == ::std::size_t(0))
         {
-            assert(!empty());
-            pop_back();
+            return;
+        }
+        auto const old_size = static_cast<::std::size_t>(size());
+        assert(count <= old_size);
+        if (count == old_size)
+        {
+            clear();
+            return;
+        }
+        if constexpr (!(::std::is_trivially_destructible_v<T> && is_default_operation_))
+        {
+            auto block = block_elem_end_ - ::std::size_t(1);
+            auto first = elem_end_begin_;
+            auto last = elem_end_end_;
+            for (auto remain = count;;)
+            {
+                auto const n = (::std::min)(remain, static_cast<::std::size_t>(last - first));
+                deque_detail::destroy_range(allocator_, last - n, last);
+                remain -= n;
+                if (remain == ::std::size_t(0))
+                {
+                    break;
+                }
+                --block;
+                // 首块的范围由elem_begin决定
+                first = block == block_elem_begin_ ? elem_begin_begin_ : ::std::to_address(*block);
+                last = block == block_elem_begin_ ? elem_begin_end_ : first + deque_detail::block_elements_v<T>;
+            }
+        }
+        // 计算新的末尾元素的位置
+        auto const res = deque_detail::calc_pos<T>(static_cast<::std::size_t>(elem_begin_begin_ - elem_begin_first_),
+                                                   old_size - count - ::std::size_t(1));
+        auto const target_block = block_elem_begin_ + res.block_step;
+        auto const begin = ::std::to_address(*target_block);
+        auto const end = begin + res.elem_step + ::std::size_t(1);
+        block_elem_end_ = target_block + ::std::size_t(1);
+        if (res.block_step == ::std::size_t(0))
+        {
+            elem_begin_end_ = end;
+            elem_end_(elem_begin_begin_, end, begin + deque_detail::block_elements_v<T>);
+        }
+        else
+        {
+            elem_end_(begin, end, begin + deque_detail::block_elements_v<T>);
         }
     }
 
+    // 参考pop_back_n_
     constexpr void pop_front_n_(::std::size_t const count) noexcept
     {
-        for (auto i = ::std::size_t(0); i != count; ++i)
+        if (count == ::std::size_t(0))
         {
-            assert(!empty());
-            pop_front();
+            return;
+        }
+        auto const old_size = static_cast<::std::size_t>(size());
+        assert(count <= old_size);
+        if (count == old_size)
+        {
+            clear();
+            return;
+        }
+        if constexpr (!(::std::is_trivially_destructible_v<T> && is_default_operation_))
+        {
+            auto block = block_elem_begin_;
+            auto first = elem_begin_begin_;
+            auto last = elem_begin_end_;
+            for (auto remain = count;;)
+            {
+                auto const n = (::std::min)(remain, static_cast<::std::size_t>(last - first));
+                deque_detail::destroy_range(allocator_, first, first + n);
+                remain -= n;
+                if (remain == ::std::size_t(0))
+                {
+                    break;
+                }
+                ++block;
+                // 尾块的范围由elem_end决定
+                first = ::std::to_address(*block);
+                last = block + ::std::size_t(1) == block_elem_end_ ? elem_end_end_
+                                                                   : first + deque_detail::block_elements_v<T>;
+            }
+        }
+        // 计算新的首元素的位置
+        auto const res = deque_detail::calc_pos<T>(static_cast<::std::size_t>(elem_begin_begin_ - elem_begin_first_),
+                                                   count);
+        block_elem_begin_ += res.block_step;
+        auto const first = ::std::to_address(*block_elem_begin_);
+        auto const begin = first + res.elem_step;
+        if (block_elem_size_() == ::std::size_t(1))
+        {
+            elem_begin_(begin, elem_end_end_, first);
+            elem_end_begin_ = begin;
+        }
+        else
+        {
+            elem_begin_(begin, first + deque_detail::block_elements_v<T>, first);
+        }
+    }
+
+    // 尾部之后的未使用空间的前count个元素，按块划分，需要时分配新块
+    // 返回的空间不含对象，只用于隐式生存期类型
+    constexpr buckets_type spare_back_(::std::size_t const count)
+    {
+        reserve_back_(count); // may throw
+        if (count == ::std::size_t(0))
+        {
+            return {};
+        }
+        // 尾块剩余的部分，空deque的尾块指针都是nullptr
+        auto const tail = static_cast<::std::size_t>(elem_end_last_ - elem_end_end_);
+        if (count <= tail)
+        {
+            return {block_elem_end_ - ::std::size_t(1),
+                    block_elem_end_,
+                    elem_end_end_,
+                    elem_end_end_ + count,
+                    elem_end_end_,
+                    elem_end_end_ + count};
+        }
+        auto const rem = count - tail;
+        auto const blocks = (rem - ::std::size_t(1)) / deque_detail::block_elements_v<T>;
+        auto const last_block = block_elem_end_ + blocks;
+        auto const last_begin = ::std::to_address(*last_block);
+        auto const last_end = last_begin + (rem - blocks * deque_detail::block_elements_v<T>);
+        if (tail != ::std::size_t(0))
+        {
+            return {block_elem_end_ - ::std::size_t(1), last_block + ::std::size_t(1), elem_end_end_, elem_end_last_,
+                    last_begin, last_end};
+        }
+        auto const first_begin = ::std::to_address(*block_elem_end_);
+        auto const first_end = blocks == ::std::size_t(0) ? last_end : first_begin + deque_detail::block_elements_v<T>;
+        return {block_elem_end_, last_block + ::std::size_t(1), first_begin, first_end, last_begin, last_end};
+    }
+
+    // 把spare_back_返回的空间的前count个元素并入deque，只调整指针
+    constexpr void commit_back_(::std::size_t count) noexcept
+    {
+        if (count == ::std::size_t(0))
+        {
+            return;
+        }
+        auto const tail = static_cast<::std::size_t>(elem_end_last_ - elem_end_end_);
+        if (count <= tail)
+        {
+            elem_end_end_ += count;
+            if (block_elem_size_() == ::std::size_t(1))
+            {
+                elem_begin_end_ = elem_end_end_;
+            }
+            return;
+        }
+        count -= tail;
+        auto const blocks = (count - ::std::size_t(1)) / deque_detail::block_elements_v<T>;
+        auto const last_block = block_elem_end_ + blocks;
+        auto const begin = ::std::to_address(*last_block);
+        auto const end = begin + (count - blocks * deque_detail::block_elements_v<T>);
+        if (empty())
+        {
+            auto const first = ::std::to_address(*block_elem_end_);
+            block_elem_begin_ = block_elem_end_;
+            elem_begin_(first, blocks == ::std::size_t(0) ? end : first + deque_detail::block_elements_v<T>, first);
         }
+        else if (block_elem_size_() == ::std::size_t(1))
+        {
+            // 首块填满
+            elem_begin_end_ = elem_end_last_;
+        }
+        block_elem_end_ = last_block + ::std::size_t(1);
+        elem_end_(begin, end, begin + deque_detail::block_elements_v<T>);
+    }
+
+    // 不分配新块时尾部还能容纳的元素数量
+    constexpr ::std::size_t spare_back_size_() const noexcept
+    {
+        return static_cast<::std::size_t>(elem_end_last_ - elem_end_end_) +
+               static_cast<::std::size_t>(block_alloc_end_ - block_elem_end_) * deque_detail::block_elements_v<T>;
     }
 
+    template <typename U, typename A>
+        requires(sizeof(U) == 1 && ::std::is_trivially_copyable_v<U>)
+    friend class dynamic_buffer;
+
+    // deque自身、控制块和所有块一起被移动了delta字节之后修正成员中的裸指针
+    // 只用于Block和BlockFP保存相对于自身地址的偏移的分配器，例如arena_allocator，控制块中的内容不需要修正
+    constexpr void rebase_(::std::ptrdiff_t const delta) noexcept
+    {
+        auto const move = [delta](auto &p) {
+            if (p != nullptr)
+            {
+                p = reinterpret_cast<::std::remove_reference_t<decltype(p)>>(reinterpret_cast<::std::uintptr_t>(p) +
+                                                                              static_cast<::std::uintptr_t>(delta));
+            }
+        };
+        move(block_ctrl_end_);
+        move(block_alloc_begin_);
+        move(block_alloc_end_);
+        move(block_elem_begin_);
+        move(block_elem_end_);
+        move(elem_begin_first_);
+        move(elem_begin_begin_);
+        move(elem_begin_end_);
+        move(elem_end_begin_);
+        move(elem_end_end_);
+        move(elem_end_last_);
+    }
+
+    template <typename U>
+        requires ::std::is_trivially_copyable_v<U>
+    friend class mapped_deque;
+
+    template <typename U>
+        requires ::std::is_trivially_copyable_v<U>
+    friend class shared_deque;
+
     template <bool back>
     class partial_guard_
     {
@@ -2841,6 +3331,18 @@ class deque
         guard.release();
     }
 
+    // 类似basic_string::resize_and_overwrite，op接受尾部之后count个元素的未初始化空间的桶，
+    // 写入之后返回实际写入的元素数量n，前n个元素并入deque，不逐个构造元素
+    // 只用于隐式生存期的类型，op抛出异常时deque的元素不变
+    template <typename Op>
+        requires(::std::is_trivially_copyable_v<T> && is_default_operation_)
+    constexpr void append_and_overwrite(size_type const count, Op op)
+    {
+        auto const written = static_cast<::std::size_t>(::std::move(op)(spare_back_(count)));
+        assert(written <= count);
+        commit_back_(written);
+    }
+
     template <::std::ranges::input_range R>
         requires ::std::convertible_to<::std::ranges::range_value_t<R>, T>
     constexpr void prepend_range(R &&rg)
@@ -2855,29 +3357,7 @@ class deque
     constexpr void resize_shrink_(::std::size_t const old_size, ::std::size_t const new_size) noexcept
     {
         assert(old_size >= new_size);
-        if constexpr (::std::is_trivially_destructible_v<T> && is_default_operation_)
-        {
-            auto const res =
-                deque_detail::calc_pos<T>(static_cast<::std::size_t>(elem_begin_begin_ - elem_begin_first_), new_size);
-            if (res.block_step == ::std::size_t(0))
-            {
-                auto const begin = elem_begin_first_;
-                elem_end_(elem_begin_begin_, begin + res.elem_step, begin + deque_detail::block_elements_v<T>);
-                block_elem_end_ = block_elem_begin_ + ::std::size_t(1);
-                elem_begin_(elem_begin_begin_, begin + res.elem_step, begin);
-            }
-            else
-            {
-                auto const target_block = block_elem_begin_ + res.block_step;
-                auto const begin = *target_block;
-                elem_end_(begin, begin + res.elem_step, begin + deque_detail::block_elements_v<T>);
-                block_elem_end_ = target_block + ::std::size_t(1);
-            }
-        }
-        else
-        {
-            pop_back_n_(old_size - new_size);
-        }
+        pop_back_n_(old_size - new_size);
     }
 
     template <typename... Ts>
@@ -3166,6 +3646,78 @@ class deque
 #endif
     }
 
+    // 一次在多个位置插入元素，items是(位置, 值)的序列，位置是插入前元素的下标，按升序排列
+    // 相同位置的元素按在items中的顺序插入，*it是右值时移动其中的值
+    // 先用reserve_back_一次扩展尾部，再从后向前一趟合并，每个原有元素最多移动一次，复杂度是O(n + k)
+    template <::std::ranges::bidirectional_range R>
+    constexpr void insert_many(R &&items)
+    {
+        auto const first = ::std::ranges::begin(items);
+        auto const last = ::std::ranges::next(first, ::std::ranges::end(items));
+        auto const count = static_cast<::std::size_t>(::std::ranges::distance(first, last));
+        if (count == ::std::size_t(0))
+        {
+            return;
+        }
+        auto const pos_of = [](auto const &it) { return static_cast<::std::size_t>(::std::get<0>(*it)); };
+        auto const old_size = static_cast<::std::size_t>(size());
+        // 先确定合并后的最后count个元素由哪些原有元素和哪些新元素组成
+        auto split = last;
+        auto src = old_size;
+        for (auto i = ::std::size_t(0); i != count; ++i)
+        {
+            if (split != first && pos_of(::std::ranges::prev(split)) >= src)
+            {
+                --split;
+            }
+            else
+            {
+                --src;
+            }
+        }
+        // 在尾部未初始化的内存上按顺序构造这count个元素
+        reserve_back_(count);
+        {
+            partial_guard_<true> guard(this, old_size);
+            auto it = split;
+            for (auto o = src; o != old_size || it != last;)
+            {
+                if (it != last && pos_of(it) <= o)
+                {
+                    auto &&item = *it;
+                    emplace_back_noalloc_(::std::get<1>(::std::forward<decltype(item)>(item)));
+                    ++it;
+                }
+                else
+                {
+                    emplace_back_noalloc_(::std::move(*(begin() + static_cast<difference_type>(o))));
+                    ++o;
+                }
+            }
+            guard.release();
+        }
+        // 其余的元素从后向前合并到已经构造的位置上
+        auto dst = begin() + static_cast<difference_type>(old_size);
+        auto orig = begin() + static_cast<difference_type>(src);
+        for (auto it = split; it != first;)
+        {
+            --dst;
+            if (auto const prev = ::std::ranges::prev(it); pos_of(prev) >= src)
+            {
+                auto &&item = *prev;
+                *dst = ::std::get<1>(::std::forward<decltype(item)>(item));
+                it = prev;
+            }
+            else
+            {
+                --src;
+                --orig;
+                *dst = ::std::move(*orig);
+            }
+        }
+    }
+
+    // 两个deque的块通常互相错开，因此按两者重叠的连续段逐段比较
     constexpr bool operator==(deque const &other) const noexcept
     {
         if (auto const s = size(); s != other.size())
@@ -3174,7 +3726,16 @@ class deque
         }
         else if (s != ::std::size_t(0))
         {
-            return ::std::equal(begin(), end(), other.begin());
+            return deque_detail::for_each_segment(*this, other, s, [](auto const x, auto const y) {
+                if constexpr (deque_detail::memcmp_equality<T>)
+                {
+                    if (!::std::is_constant_evaluated())
+                    {
+                        return ::std::memcmp(x.data(), y.data(), x.size_bytes()) == 0;
+                    }
+                }
+                return ::std::equal(x.begin(), x.end(), y.begin());
+            });
         }
         return true;
     }
@@ -3184,7 +3745,40 @@ class deque
             { t < t1 } -> ::std::convertible_to<bool>;
         }
     {
-        return ::std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end(), synth_three_way_);
+        using ordering = decltype(synth_three_way_(::std::declval<T const &>(), ::std::declval<T const &>()));
+        auto const s = size();
+        auto const other_s = other.size();
+        auto result = ordering(::std::strong_ordering::equal);
+        deque_detail::for_each_segment(*this, other, (::std::min)(s, other_s), [&result](auto const x, auto const y) {
+            if constexpr (deque_detail::memcmp_equality<T>)
+            {
+                if (!::std::is_constant_evaluated())
+                {
+                    auto const r = ::std::memcmp(x.data(), y.data(), x.size_bytes());
+                    if (r == 0)
+                    {
+                        return true;
+                    }
+                    if constexpr (deque_detail::memcmp_ordering<T>)
+                    {
+                        result = ordering(r <=> 0);
+                        return false;
+                    }
+                }
+            }
+            auto const [i, j] = ::std::mismatch(x.begin(), x.end(), y.begin());
+            if (i == x.end())
+            {
+                return true;
+            }
+            result = synth_three_way_(*i, *j);
+            return false;
+        });
+        if (result != 0)
+        {
+            return result;
+        }
+        return ordering(s <=> other_s);
     }
 
     constexpr iterator erase(const_iterator const pos) noexcept(::std::is_nothrow_move_assignable_v<value_type>)
@@ -3273,22 +3867,100 @@ template <::std::ranges::input_range R, typename Alloc = ::std::allocator<::std:
 deque(::std::from_range_t, R &&, Alloc = Alloc()) -> deque<::std::ranges::range_value_t<R>, Alloc>;
 #endif
 
+namespace deque_detail
+{
+// 单趟压缩：读游标逐桶遍历，被保留的元素移动到写游标处，写游标在桶用完时才前进到下一个桶
+// remove(e, last)为真时移除e，last指向上一个被保留的元素，没有时为空指针
+// 尾部由erase交给pop_back_n_，按块析构
+template <typename T, typename Alloc, typename Remove>
+inline constexpr auto compact(deque<T, Alloc> &c, Remove remove)
+{
+    auto buckets = c.buckets();
+    auto const count = static_cast<::std::size_t>(buckets.size());
+    auto write_bucket = ::std::size_t(0);
+    T *write = nullptr;
+    T *write_end = nullptr;
+    T *last = nullptr;
+    auto kept = ::std::size_t(0);
+    for (auto i = ::std::size_t(0); i != count; ++i)
+    {
+        auto const bucket = buckets.at(i);
+        for (auto first = bucket.data(), end = first + bucket.size(); first != end; ++first)
+        {
+            if (remove(*first, static_cast<T const *>(last)))
+            {
+                continue;
+            }
+            if (write == write_end)
+            {
+                auto const out = buckets.at(write_bucket++);
+                write = out.data();
+                write_end = write + out.size();
+            }
+            if (write != first)
+            {
+                *write = ::std::move(*first);
+            }
+            last = write;
+            ++write;
+            ++kept;
+        }
+    }
+    auto const r = static_cast<::std::size_t>(c.size()) - kept;
+    c.erase(c.begin() + static_cast<deque<T, Alloc>::difference_type>(kept), c.end());
+    return static_cast<deque<T, Alloc>::size_type>(r);
+}
+} // namespace deque_detail
+
 BIZWEN_EXPORT template <typename T, typename Alloc, typename U = T>
 inline constexpr auto erase(deque<T, Alloc> &c, U const &value)
 {
-    auto const it = ::std::remove(c.begin(), c.end(), value);
-    auto const r = static_cast<deque<T, Alloc>::size_type>(c.end() - it);
-    c.resize(c.size() - r);
-    return r;
+    return deque_detail::compact(c, [&value](T const &e, T const *) { return e == value; });
 }
 
 BIZWEN_EXPORT template <typename T, typename Alloc, typename Pred>
 inline constexpr auto erase_if(deque<T, Alloc> &c, Pred pred)
 {
-    auto const it = ::std::remove_if(c.begin(), c.end(), ::std::move(pred));
-    auto const r = static_cast<deque<T, Alloc>::size_type>(c.end() - it);
-    c.resize(c.size() - r);
-    return r;
+    return deque_detail::compact(c, [&pred](T &e, T const *) { return static_cast<bool>(pred(e)); });
+}
+
+// 一次移除多个位置上的元素，positions是升序的位置序列，可以有重复
+// 只遍历一次容器，复杂度是O(n + k)，而逐个erase是O(n * k)
+BIZWEN_EXPORT template <typename T, typename Alloc, ::std::ranges::input_range R>
+    requires ::std::convertible_to<::std::ranges::range_reference_t<R>, ::std::size_t>
+inline constexpr auto erase_indices(deque<T, Alloc> &c, R &&positions)
+{
+    auto first = ::std::ranges::begin(positions);
+    auto const last = ::std::ranges::end(positions);
+    return deque_detail::compact(c, [&first, &last, i = ::std::size_t(0)](T const &, T const *) mutable {
+        auto const r = first != last && static_cast<::std::size_t>(*first) == i;
+        while (first != last && static_cast<::std::size_t>(*first) == i)
+        {
+            ++first;
+        }
+        ++i;
+        return r;
+    });
+}
+
+// 移除marks中对应位置为真的元素，marks的长度不小于容器的大小，例如vector<bool>
+BIZWEN_EXPORT template <typename T, typename Alloc, ::std::ranges::input_range R>
+    requires ::std::convertible_to<::std::ranges::range_reference_t<R>, bool>
+inline constexpr auto erase_marked(deque<T, Alloc> &c, R &&marks)
+{
+    return deque_detail::compact(c, [it = ::std::ranges::begin(marks)](T const &, T const *) mutable {
+        auto const r = static_cast<bool>(*it);
+        ++it;
+        return r;
+    });
+}
+
+// 与std::list::unique相同，移除连续的等价元素中除第一个之外的元素，返回移除的个数
+BIZWEN_EXPORT template <typename T, typename Alloc, typename Pred = ::std::equal_to<>>
+inline constexpr auto unique(deque<T, Alloc> &c, Pred pred = Pred())
+{
+    return deque_detail::compact(
+        c, [&pred](T &e, T const *const last) { return last != nullptr && static_cast<bool>(pred(*last, e)); });
 }
 
 namespace pmr
@@ -3298,6 +3970,51 @@ using deque = deque<T, ::std::pmr::polymorphic_allocator<T>>;
 }
 } // namespace bizwen
 
+namespace std
+{
+// 与块布局无关，等于对元素相同的连续序列调用operator()(span)的结果
+// 具有唯一对象表示的可平凡复制类型逐桶按字节哈希，其他类型逐个输入std::hash<T>的结果
+template <typename T, typename Alloc>
+    requires(::bizwen::deque_detail::byte_hashable<T> || requires(T const &t) { ::std::hash<T>{}(t); })
+struct hash<::bizwen::deque<T, Alloc>>
+{
+  private:
+    static void update_(::bizwen::deque_detail::byte_hasher &hasher, ::std::span<T const> const s)
+    {
+        if constexpr (::bizwen::deque_detail::byte_hashable<T>)
+        {
+            hasher.update(s.data(), s.size_bytes());
+        }
+        else
+        {
+            for (auto const &e : s)
+            {
+                auto const h = ::std::hash<T>{}(e);
+                hasher.update(&h, sizeof(h));
+            }
+        }
+    }
+
+  public:
+    ::std::size_t operator()(::bizwen::deque<T, Alloc> const &d) const
+    {
+        ::bizwen::deque_detail::byte_hasher hasher;
+        for (auto const bucket : d.buckets())
+        {
+            update_(hasher, bucket);
+        }
+        return hasher.finish();
+    }
+
+    ::std::size_t operator()(::std::span<T const> const s) const
+    {
+        ::bizwen::deque_detail::byte_hasher hasher;
+        update_(hasher, s);
+        return hasher.finish();
+    }
+};
+} // namespace std
+
 // STL-vNext END
 
 #pragma pop_macro("BIZWEN_EXPORT")
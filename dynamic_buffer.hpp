@@ -0,0 +1,118 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_DYNAMIC_BUFFER_HPP)
+#define BIZWEN_DYNAMIC_BUFFER_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// deque
+#include "./deque.hpp"
+// size_t
+#include <cstddef>
+// min
+#include <algorithm>
+// addressof
+#include <memory>
+// length_error
+#include <stdexcept>
+// is_trivially_copyable
+#include <type_traits>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+// 按照Asio的DynamicBuffer(v1)接口把deque<std::byte>用作网络收发缓冲区
+// data()是可读部分的桶，prepare(n)是尾部之后按块划分的可写空间，两者都是span的序列，可以直接传给readv/writev
+// commit和consume只调整块指针，不逐字节处理，也不复制数据；消费完的块留在deque中，之后的prepare会重用它们
+// prepare返回的空间在下一次修改deque之前有效
+BIZWEN_EXPORT template <typename T, typename Alloc>
+    requires(sizeof(T) == 1 && ::std::is_trivially_copyable_v<T>)
+class dynamic_buffer
+{
+    deque<T, Alloc> *deque_;
+    ::std::size_t max_size_;
+    // prepare返回的空间大小
+    ::std::size_t prepared_{};
+
+  public:
+    using const_buffers_type = typename deque<T, Alloc>::const_buckets_type;
+    using mutable_buffers_type = typename deque<T, Alloc>::buckets_type;
+
+    explicit dynamic_buffer(deque<T, Alloc> &d) noexcept
+        : deque_(::std::addressof(d)), max_size_(static_cast<::std::size_t>(d.max_size()))
+    {
+    }
+
+    dynamic_buffer(deque<T, Alloc> &d, ::std::size_t const max_size) noexcept
+        : deque_(::std::addressof(d)), max_size_(max_size)
+    {
+    }
+
+    ::std::size_t size() const noexcept
+    {
+        return static_cast<::std::size_t>(deque_->size());
+    }
+
+    ::std::size_t max_size() const noexcept
+    {
+        return max_size_;
+    }
+
+    // 不分配新块时能容纳的字节数
+    ::std::size_t capacity() const noexcept
+    {
+        return size() + deque_->spare_back_size_();
+    }
+
+    const_buffers_type data() const noexcept
+    {
+        return static_cast<deque<T, Alloc> const *>(deque_)->buckets();
+    }
+
+    mutable_buffers_type prepare(::std::size_t const count)
+    {
+        auto const size = this->size();
+        if (size > max_size_ || max_size_ - size < count)
+        {
+            throw ::std::length_error("dynamic_buffer too long");
+        }
+        auto result = deque_->spare_back_(count); // may throw
+        prepared_ = count;
+        return result;
+    }
+
+    // 与Asio相同，count超过prepare的大小时只提交prepare的部分
+    void commit(::std::size_t const count) noexcept
+    {
+        deque_->commit_back_((::std::min)(count, prepared_));
+        prepared_ = ::std::size_t(0);
+    }
+
+    // count超过size()时清空
+    void consume(::std::size_t const count) noexcept
+    {
+        deque_->pop_front_n_((::std::min)(count, size()));
+    }
+};
+
+template <typename T, typename Alloc>
+dynamic_buffer(deque<T, Alloc> &) -> dynamic_buffer<T, Alloc>;
+
+template <typename T, typename Alloc>
+dynamic_buffer(deque<T, Alloc> &, ::std::size_t) -> dynamic_buffer<T, Alloc>;
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
@@ -0,0 +1,229 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_HUGE_PAGE_HPP)
+#define BIZWEN_HUGE_PAGE_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// assert
+#include <cassert>
+// size_t/byte
+#include <cstddef>
+// uintptr_t
+#include <cstdint>
+// min/max
+#include <algorithm>
+// bit_width
+#include <bit>
+// mutex/lock_guard
+#include <mutex>
+// bad_alloc
+#include <new>
+// true_type/false_type
+#include <type_traits>
+
+// mmap/munmap/madvise
+#include <sys/mman.h>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+// 从2MiB对齐的透明大页区域中分配内存的资源，仅用于POSIX系统
+// 每次映射一个2MiB对齐的区域并madvise(MADV_HUGEPAGE)，然后把它按2的幂分级切分，每级一个空闲链表
+// deque的块大小固定，因此同一个区域中几乎全是块，遍历和随机访问时每个大页只需要一个TLB项
+// 不小于区域四分之一的分配（例如大型deque的控制块）单独映射，大小向上取整到2MiB，释放时立即解除映射
+// 切分出的内存释放后只回到空闲链表，资源析构时才解除映射；系统不支持透明大页时退化为普通页
+// 线程安全
+BIZWEN_EXPORT class huge_page_resource
+{
+    static constexpr ::std::size_t huge_page_size_ = ::std::size_t(1) << 21;
+    static constexpr ::std::size_t direct_size_ = huge_page_size_ / 4u;
+    static constexpr ::std::size_t min_size_ = 16u;
+    static constexpr ::std::size_t max_align_ = 4096u;
+    static constexpr ::std::size_t classes_ = 21u;
+
+    ::std::mutex mutex_{};
+    // 空闲内存的前8字节保存下一个空闲内存的地址
+    void *free_[classes_]{};
+    ::std::byte *current_{};
+    ::std::byte *end_{};
+    // 区域的前8字节保存上一个区域的地址
+    void *regions_{};
+
+    static ::std::size_t class_of_(::std::size_t const bytes) noexcept
+    {
+        return static_cast<::std::size_t>(::std::bit_width(bytes < min_size_ ? min_size_ - 1u : bytes - 1u));
+    }
+
+    static ::std::size_t round_(::std::size_t const bytes) noexcept
+    {
+        return (bytes + (huge_page_size_ - 1u)) & ~(huge_page_size_ - 1u);
+    }
+
+    // 多映射一个大页，然后解除首尾不对齐的部分
+    static void *map_(::std::size_t const bytes)
+    {
+        if (bytes > ::std::size_t(-1) - huge_page_size_)
+        {
+            throw ::std::bad_alloc{};
+        }
+        auto const p =
+            ::mmap(nullptr, bytes + huge_page_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+        {
+            throw ::std::bad_alloc{};
+        }
+        auto const address = reinterpret_cast<::std::uintptr_t>(p);
+        auto const head = (huge_page_size_ - address % huge_page_size_) % huge_page_size_;
+        auto const begin = static_cast<::std::byte *>(p) + head;
+        if (head != 0u)
+        {
+            ::munmap(p, head);
+        }
+        ::munmap(begin + bytes, huge_page_size_ - head);
+#if defined(MADV_HUGEPAGE)
+        // 只是提示，失败时仍然可以使用普通页
+        ::madvise(begin, bytes, MADV_HUGEPAGE);
+#endif
+        return begin;
+    }
+
+  public:
+    huge_page_resource() noexcept = default;
+
+    huge_page_resource(huge_page_resource const &) = delete;
+
+    huge_page_resource &operator=(huge_page_resource const &) = delete;
+
+    // 调用前必须释放所有单独映射的内存
+    ~huge_page_resource()
+    {
+        for (auto region = regions_; region != nullptr;)
+        {
+            auto const previous = *static_cast<void **>(region);
+            ::munmap(region, huge_page_size_);
+            region = previous;
+        }
+    }
+
+    // 默认的资源，从不析构，因此静态存储期的deque也可以使用
+    static huge_page_resource &global()
+    {
+        static auto *const resource = new huge_page_resource;
+        return *resource;
+    }
+
+    void *allocate(::std::size_t const bytes, ::std::size_t const align)
+    {
+        assert(align <= max_align_);
+        if (bytes >= direct_size_)
+        {
+            return map_(round_(bytes));
+        }
+        auto const c = class_of_(bytes);
+        ::std::lock_guard<::std::mutex> const lock{mutex_};
+        if (auto const head = free_[c])
+        {
+            free_[c] = *static_cast<void **>(head);
+            return head;
+        }
+        auto const size = ::std::size_t(1) << c;
+        auto const alignment = (::std::max)(align, (::std::min)(size, max_align_));
+        auto const address = reinterpret_cast<::std::uintptr_t>(current_);
+        auto offset = (alignment - address % alignment) % alignment;
+        if (current_ == nullptr || static_cast<::std::size_t>(end_ - current_) < offset + size)
+        {
+            // 当前区域的剩余部分不再使用
+            auto const region = static_cast<::std::byte *>(map_(huge_page_size_));
+            *reinterpret_cast<void **>(region) = regions_;
+            regions_ = region;
+            current_ = region + sizeof(void *);
+            end_ = region + huge_page_size_;
+            offset = alignment - sizeof(void *);
+        }
+        auto const p = current_ + offset;
+        current_ = p + size;
+        return p;
+    }
+
+    void deallocate(void *const p, ::std::size_t const bytes) noexcept
+    {
+        if (bytes >= direct_size_)
+        {
+            ::munmap(p, round_(bytes));
+            return;
+        }
+        auto const c = class_of_(bytes);
+        ::std::lock_guard<::std::mutex> const lock{mutex_};
+        *static_cast<void **>(p) = free_[c];
+        free_[c] = p;
+    }
+};
+
+// 从huge_page_resource分配的分配器，默认使用huge_page_resource::global()
+BIZWEN_EXPORT template <typename T>
+class huge_page_allocator
+{
+    huge_page_resource *resource_{&huge_page_resource::global()};
+
+  public:
+    using value_type = T;
+    using size_type = ::std::size_t;
+    using difference_type = ::std::ptrdiff_t;
+    using propagate_on_container_copy_assignment = ::std::true_type;
+    using propagate_on_container_move_assignment = ::std::true_type;
+    using propagate_on_container_swap = ::std::true_type;
+    using is_always_equal = ::std::false_type;
+
+    huge_page_allocator() = default;
+
+    explicit huge_page_allocator(huge_page_resource *const resource) noexcept : resource_(resource)
+    {
+    }
+
+    template <typename U>
+    huge_page_allocator(huge_page_allocator<U> const &other) noexcept : resource_(other.resource())
+    {
+    }
+
+    huge_page_resource *resource() const noexcept
+    {
+        return resource_;
+    }
+
+    T *allocate(::std::size_t const n)
+    {
+        if (n > ::std::size_t(-1) / sizeof(T))
+        {
+            throw ::std::bad_alloc{};
+        }
+        return static_cast<T *>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *const p, ::std::size_t const n) noexcept
+    {
+        resource_->deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    friend bool operator==(huge_page_allocator const &lhs, huge_page_allocator<U> const &rhs) noexcept
+    {
+        return lhs.resource() == rhs.resource();
+    }
+};
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
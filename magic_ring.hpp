@@ -0,0 +1,464 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_MAGIC_RING_HPP)
+#define BIZWEN_MAGIC_RING_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// assert
+#include <cassert>
+// size_t/byte
+#include <cstddef>
+// memcpy
+#include <cstring>
+// max
+#include <algorithm>
+// bad_alloc
+#include <new>
+// contiguous_iterator
+#include <iterator>
+// input_range/contiguous_range/single_view
+#include <ranges>
+// span
+#include <span>
+// out_of_range
+#include <stdexcept>
+// is_trivially_copyable
+#include <type_traits>
+// exchange/swap
+#include <utility>
+
+// memfd_create/mmap/munmap
+#include <sys/mman.h>
+// ftruncate/close/sysconf
+#include <unistd.h>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+// 字节环形缓冲区，仅用于Linux
+// 同一个memfd被连续映射两次，因此环中任意一段可读数据都是一个连续的span，包括跨越环尾的部分
+// 接口和deque<char>的push_back/append_range/pop_front相同，contiguous_front(n)直接返回前n个元素
+// 容量是页大小的倍数，写满时分配两倍容量的新环并复制一次
+BIZWEN_EXPORT template <typename T = char>
+    requires(sizeof(T) == 1 && ::std::is_trivially_copyable_v<T>)
+class magic_ring
+{
+  public:
+    using value_type = T;
+    using size_type = ::std::size_t;
+    using difference_type = ::std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = T const &;
+    using pointer = T *;
+    using const_pointer = T const *;
+    using iterator = T *;
+    using const_iterator = T const *;
+
+  private:
+    // 两次映射的起始地址，大小为2 * cap_
+    T *base_{};
+    ::std::size_t cap_{};
+    ::std::size_t head_{};
+    ::std::size_t size_{};
+
+    static ::std::size_t page_size_() noexcept
+    {
+        static ::std::size_t const size = static_cast<::std::size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    // 先保留2 * cap的地址，再把memfd固定映射到前后两半
+    static T *map_(::std::size_t const cap)
+    {
+        auto const fd = ::memfd_create("bizwen::magic_ring", MFD_CLOEXEC);
+        if (fd == -1)
+        {
+            throw ::std::bad_alloc{};
+        }
+        auto const area = ::mmap(nullptr, cap * ::std::size_t(2), PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        auto ok = area != MAP_FAILED && ::ftruncate(fd, static_cast<::off_t>(cap)) == 0;
+        if (ok)
+        {
+            auto const first = static_cast<::std::byte *>(area);
+            ok = ::mmap(first, cap, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+                 ::mmap(first + cap, cap, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+        }
+        // 映射持有文件的引用
+        ::close(fd);
+        if (!ok)
+        {
+            if (area != MAP_FAILED)
+            {
+                ::munmap(area, cap * ::std::size_t(2));
+            }
+            throw ::std::bad_alloc{};
+        }
+        return static_cast<T *>(area);
+    }
+
+    void unmap_() noexcept
+    {
+        if (base_ != nullptr)
+        {
+            ::munmap(base_, cap_ * ::std::size_t(2));
+        }
+    }
+
+    // 换到至少能容纳count个元素的新环，元素复制到新环的开头，然后追加[src, src + add)
+    // src可能指向旧环，因此在解除旧环的映射之前复制
+    void reallocate_(::std::size_t const count, T const *const src = nullptr, ::std::size_t const add = 0u)
+    {
+        assert(count >= size_ + add);
+        auto const page = page_size_();
+        auto const cap = (count + page - ::std::size_t(1)) / page * page;
+        auto const base = map_(cap);
+        if (size_ != ::std::size_t(0))
+        {
+            ::std::memcpy(base, base_ + head_, size_);
+        }
+        if (add != ::std::size_t(0))
+        {
+            ::std::memcpy(base + size_, src, add);
+        }
+        unmap_();
+        base_ = base;
+        cap_ = cap;
+        head_ = ::std::size_t(0);
+        size_ += add;
+    }
+
+    ::std::size_t grow_size_(::std::size_t const add) const noexcept
+    {
+        return (::std::max)(size_ + add, cap_ * ::std::size_t(2));
+    }
+
+    void reserve_back_(::std::size_t const add)
+    {
+        if (cap_ - size_ < add)
+        {
+            reserve(grow_size_(add));
+        }
+    }
+
+  public:
+    magic_ring() noexcept = default;
+
+    // 预先分配至少capacity个元素的容量
+    explicit magic_ring(::std::size_t const capacity)
+    {
+        reserve(capacity);
+    }
+
+    magic_ring(magic_ring const &other)
+    {
+        reserve(other.size_);
+        append(other.contiguous_front(other.size_));
+    }
+
+    magic_ring(magic_ring &&other) noexcept
+        : base_(::std::exchange(other.base_, nullptr)), cap_(::std::exchange(other.cap_, ::std::size_t(0))),
+          head_(::std::exchange(other.head_, ::std::size_t(0))), size_(::std::exchange(other.size_, ::std::size_t(0)))
+    {
+    }
+
+    magic_ring &operator=(magic_ring const &other)
+    {
+        if (this != &other)
+        {
+            magic_ring temp(other);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    magic_ring &operator=(magic_ring &&other) noexcept
+    {
+        magic_ring temp(::std::move(other));
+        swap(temp);
+        return *this;
+    }
+
+    ~magic_ring()
+    {
+        unmap_();
+    }
+
+    void swap(magic_ring &other) noexcept
+    {
+        using ::std::swap;
+        swap(base_, other.base_);
+        swap(cap_, other.cap_);
+        swap(head_, other.head_);
+        swap(size_, other.size_);
+    }
+
+    friend void swap(magic_ring &lhs, magic_ring &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == ::std::size_t(0);
+    }
+
+    size_type capacity() const noexcept
+    {
+        return cap_;
+    }
+
+    void reserve(::std::size_t const count)
+    {
+        if (count > cap_)
+        {
+            reallocate_(count);
+        }
+    }
+
+    // 容量缩小到能容纳当前元素的最少页数
+    void shrink_to_fit()
+    {
+        if (size_ == ::std::size_t(0))
+        {
+            unmap_();
+            base_ = nullptr;
+            cap_ = ::std::size_t(0);
+            head_ = ::std::size_t(0);
+        }
+        else if ((size_ + page_size_() - ::std::size_t(1)) / page_size_() * page_size_() < cap_)
+        {
+            reallocate_(size_);
+        }
+    }
+
+    iterator begin() noexcept
+    {
+        return base_ + head_;
+    }
+
+    iterator end() noexcept
+    {
+        return base_ + head_ + size_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return base_ + head_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return base_ + head_ + size_;
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    // 前n个元素，即使跨越环尾也是连续的
+    ::std::span<T> contiguous_front(::std::size_t const count) noexcept
+    {
+        assert(count <= size_);
+        return ::std::span<T>(base_ + head_, count);
+    }
+
+    ::std::span<T const> contiguous_front(::std::size_t const count) const noexcept
+    {
+        assert(count <= size_);
+        return ::std::span<T const>(base_ + head_, count);
+    }
+
+    // 只有一个桶
+    ::std::ranges::single_view<::std::span<T>> buckets() noexcept
+    {
+        return ::std::ranges::single_view<::std::span<T>>(contiguous_front(size_));
+    }
+
+    ::std::ranges::single_view<::std::span<T const>> buckets() const noexcept
+    {
+        return ::std::ranges::single_view<::std::span<T const>>(contiguous_front(size_));
+    }
+
+    T &operator[](size_type const pos) noexcept
+    {
+        assert(pos < size_);
+        return base_[head_ + pos];
+    }
+
+    T const &operator[](size_type const pos) const noexcept
+    {
+        assert(pos < size_);
+        return base_[head_ + pos];
+    }
+
+    T &at(size_type const pos)
+    {
+        if (pos >= size_)
+        {
+            throw ::std::out_of_range("magic_ring::at");
+        }
+        return base_[head_ + pos];
+    }
+
+    T const &at(size_type const pos) const
+    {
+        if (pos >= size_)
+        {
+            throw ::std::out_of_range("magic_ring::at");
+        }
+        return base_[head_ + pos];
+    }
+
+    T &front() noexcept
+    {
+        assert(!empty());
+        return base_[head_];
+    }
+
+    T const &front() const noexcept
+    {
+        assert(!empty());
+        return base_[head_];
+    }
+
+    T &back() noexcept
+    {
+        assert(!empty());
+        return base_[head_ + size_ - ::std::size_t(1)];
+    }
+
+    T const &back() const noexcept
+    {
+        assert(!empty());
+        return base_[head_ + size_ - ::std::size_t(1)];
+    }
+
+    void push_back(T const value)
+    {
+        reserve_back_(::std::size_t(1));
+        base_[head_ + size_] = value;
+        ++size_;
+    }
+
+    // 连续范围直接复制，写入的区域同样可能跨越环尾
+    // rg可以引用本环中的元素，例如r.append(r.contiguous_front(n))，换到新环时先复制再解除旧环的映射
+    template <::std::ranges::input_range R>
+        requires ::std::convertible_to<::std::ranges::range_value_t<R>, T>
+    void append_range(R &&rg)
+    {
+        if constexpr (::std::ranges::contiguous_range<R> && ::std::ranges::sized_range<R> &&
+                      ::std::is_same_v<::std::ranges::range_value_t<R>, T>)
+        {
+            auto const count = static_cast<::std::size_t>(::std::ranges::size(rg));
+            if (count == ::std::size_t(0))
+            {
+                return;
+            }
+            if (cap_ - size_ < count)
+            {
+                reallocate_(grow_size_(count), ::std::ranges::data(rg), count);
+                return;
+            }
+            ::std::memcpy(base_ + head_ + size_, ::std::ranges::data(rg), count);
+            size_ += count;
+        }
+        else if constexpr (::std::ranges::sized_range<R>)
+        {
+            auto const count = static_cast<::std::size_t>(::std::ranges::size(rg));
+            if (cap_ - size_ >= count)
+            {
+                for (auto &&e : rg)
+                {
+                    base_[head_ + size_] = static_cast<T>(e);
+                    ++size_;
+                }
+                return;
+            }
+            // 先收集到临时的环中，再按连续范围追加
+            magic_ring temp(count);
+            temp.append_range(::std::forward<R>(rg));
+            append_range(temp.contiguous_front(temp.size_));
+        }
+        else
+        {
+            magic_ring temp{};
+            for (auto &&e : rg)
+            {
+                temp.push_back(static_cast<T>(e));
+            }
+            append_range(temp.contiguous_front(temp.size_));
+        }
+    }
+
+    void append(::std::span<T const> const s)
+    {
+        append_range(s);
+    }
+
+    void pop_front() noexcept
+    {
+        pop_front(::std::size_t(1));
+    }
+
+    void pop_front(::std::size_t const count) noexcept
+    {
+        assert(count <= size_);
+        head_ += count;
+        if (head_ >= cap_)
+        {
+            head_ -= cap_;
+        }
+        size_ -= count;
+    }
+
+    void pop_back() noexcept
+    {
+        pop_back(::std::size_t(1));
+    }
+
+    void pop_back(::std::size_t const count) noexcept
+    {
+        assert(count <= size_);
+        size_ -= count;
+    }
+
+    void clear() noexcept
+    {
+        head_ = ::std::size_t(0);
+        size_ = ::std::size_t(0);
+    }
+
+    bool operator==(magic_ring const &other) const noexcept
+    {
+        return size_ == other.size_ &&
+               (size_ == ::std::size_t(0) || ::std::memcmp(base_ + head_, other.base_ + other.head_, size_) == 0);
+    }
+};
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
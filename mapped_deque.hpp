@@ -0,0 +1,277 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_MAPPED_DEQUE_HPP)
+#define BIZWEN_MAPPED_DEQUE_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// deque
+#include "./deque.hpp"
+// offset_arena/arena_allocator
+#include "./offset_ptr.hpp"
+// errno
+#include <cerrno>
+// size_t/ptrdiff_t/byte
+#include <cstddef>
+// uint32_t/uint64_t/uintptr_t
+#include <cstdint>
+// memcmp/memcpy
+#include <cstring>
+// runtime_error
+#include <stdexcept>
+// system_error
+#include <system_error>
+// placement new
+#include <new>
+// is_trivially_copyable
+#include <type_traits>
+// exchange
+#include <utility>
+
+// open
+#include <fcntl.h>
+// flock
+#include <sys/file.h>
+// mmap/msync/munmap
+#include <sys/mman.h>
+// fstat
+#include <sys/stat.h>
+// ftruncate/close
+#include <unistd.h>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+// 保存在内存映射文件中的deque，仅用于POSIX系统
+// 文件开头是文件头和deque对象，之后是offset_arena管理的控制块和所有块，块指针都是offset_ptr
+// 重新打开时文件可能被映射到不同的地址，此时只修正deque对象中的裸指针，不读取也不移动任何元素，因此打开的时间和元素数量无关
+// 文件的大小在创建时固定，并且是稀疏的，只有使用过的页占用空间
+// 修改直接写入共享映射，进程退出后也保留在文件中；checkpoint()用msync等待修改写入存储设备
+// 同一时间只能有一个mapped_deque打开同一个文件，打开时用flock加排他锁，文件已被打开时抛出异常
+BIZWEN_EXPORT template <typename T>
+    requires ::std::is_trivially_copyable_v<T>
+class mapped_deque
+{
+  public:
+    using deque_type = deque<T, arena_allocator<T>>;
+
+  private:
+    static constexpr char magic_[8] = {'B', 'Z', 'M', 'A', 'P', 'D', 'Q', '\0'};
+    static constexpr ::std::uint32_t version_ = 1u;
+
+    struct file_layout_
+    {
+        char magic[8];
+        ::std::uint32_t version;
+        ::std::uint32_t element_size;
+        ::std::uint64_t capacity;
+        // 上一次打开时的映射地址
+        ::std::uint64_t base;
+        deque_type container;
+        // 必须是最后一个成员，它管理之后的全部内存
+        offset_arena arena;
+    };
+
+    file_layout_ *layout_{};
+    ::std::size_t size_{};
+    int fd_{-1};
+
+    [[noreturn]] static void throw_errno_(char const *const what)
+    {
+        throw ::std::system_error(errno, ::std::generic_category(), what);
+    }
+
+    void close_() noexcept
+    {
+        if (layout_ != nullptr)
+        {
+            ::munmap(layout_, size_);
+        }
+        if (fd_ != -1)
+        {
+            ::close(fd_);
+        }
+        layout_ = nullptr;
+        fd_ = -1;
+    }
+
+    void open_(char const *const path, ::std::size_t capacity)
+    {
+        fd_ = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ == -1)
+        {
+            throw_errno_("bizwen::mapped_deque: open");
+        }
+        // 锁随文件描述符在close_中释放，进程退出时也会释放
+        if (::flock(fd_, LOCK_EX | LOCK_NB) != 0)
+        {
+            throw_errno_("bizwen::mapped_deque: flock");
+        }
+        struct ::stat st{};
+        if (::fstat(fd_, &st) != 0)
+        {
+            throw_errno_("bizwen::mapped_deque: fstat");
+        }
+        auto const create = st.st_size == 0;
+        if (create)
+        {
+            if (capacity < sizeof(file_layout_) + ::std::size_t(65536))
+            {
+                capacity = sizeof(file_layout_) + ::std::size_t(65536);
+            }
+            if (::ftruncate(fd_, static_cast<::off_t>(capacity)) != 0)
+            {
+                throw_errno_("bizwen::mapped_deque: ftruncate");
+            }
+        }
+        else
+        {
+            capacity = static_cast<::std::size_t>(st.st_size);
+            if (capacity < sizeof(file_layout_))
+            {
+                throw ::std::runtime_error("bizwen::mapped_deque: not a mapped deque file");
+            }
+        }
+        auto const p = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED)
+        {
+            throw_errno_("bizwen::mapped_deque: mmap");
+        }
+        layout_ = static_cast<file_layout_ *>(p);
+        size_ = capacity;
+        auto const base = static_cast<::std::uint64_t>(reinterpret_cast<::std::uintptr_t>(p));
+        if (create)
+        {
+            auto const l = layout_;
+            l->version = version_;
+            l->element_size = static_cast<::std::uint32_t>(sizeof(T));
+            l->capacity = capacity;
+            l->base = base;
+            auto const arena_offset = static_cast<::std::size_t>(reinterpret_cast<::std::byte *>(&l->arena) -
+                                                                  reinterpret_cast<::std::byte *>(l));
+            auto const arena = ::new (static_cast<void *>(&l->arena)) offset_arena(capacity - arena_offset);
+            ::new (static_cast<void *>(&l->container)) deque_type(arena_allocator<T>(arena));
+            // 文件头最后写入魔数
+            ::std::memcpy(l->magic, magic_, sizeof(magic_));
+            return;
+        }
+        if (::std::memcmp(layout_->magic, magic_, sizeof(magic_)) != 0 || layout_->version != version_ ||
+            layout_->capacity != capacity)
+        {
+            throw ::std::runtime_error("bizwen::mapped_deque: not a mapped deque file of a supported version");
+        }
+        if (layout_->element_size != sizeof(T))
+        {
+            throw ::std::runtime_error("bizwen::mapped_deque: element size mismatch");
+        }
+        if (layout_->base != base)
+        {
+            layout_->container.rebase_(static_cast<::std::ptrdiff_t>(base - layout_->base));
+            layout_->base = base;
+        }
+    }
+
+  public:
+    // 打开path，文件不存在或者为空时创建一个大小为capacity字节的文件，否则忽略capacity
+    mapped_deque(char const *const path, ::std::size_t const capacity)
+    {
+        struct guard
+        {
+            mapped_deque *self;
+
+            ~guard()
+            {
+                if (self != nullptr)
+                {
+                    self->close_();
+                }
+            }
+        } guard{this};
+        open_(path, capacity);
+        guard.self = nullptr;
+    }
+
+    mapped_deque(mapped_deque &&other) noexcept
+        : layout_(::std::exchange(other.layout_, nullptr)), size_(other.size_), fd_(::std::exchange(other.fd_, -1))
+    {
+    }
+
+    mapped_deque &operator=(mapped_deque &&other) noexcept
+    {
+        if (this != &other)
+        {
+            close_();
+            layout_ = ::std::exchange(other.layout_, nullptr);
+            size_ = other.size_;
+            fd_ = ::std::exchange(other.fd_, -1);
+        }
+        return *this;
+    }
+
+    // 不析构deque，元素留在文件中
+    ~mapped_deque()
+    {
+        close_();
+    }
+
+    deque_type &get() noexcept
+    {
+        return layout_->container;
+    }
+
+    deque_type const &get() const noexcept
+    {
+        return layout_->container;
+    }
+
+    deque_type &operator*() noexcept
+    {
+        return get();
+    }
+
+    deque_type const &operator*() const noexcept
+    {
+        return get();
+    }
+
+    deque_type *operator->() noexcept
+    {
+        return &get();
+    }
+
+    deque_type const *operator->() const noexcept
+    {
+        return &get();
+    }
+
+    // 文件中还没有使用过的字节数，释放的块会被重用，不计入其中
+    ::std::size_t unused() const noexcept
+    {
+        return layout_->arena.unused();
+    }
+
+    // 等待所有修改写入存储设备
+    void checkpoint()
+    {
+        if (::msync(layout_, size_, MS_SYNC) != 0)
+        {
+            throw_errno_("bizwen::mapped_deque: msync");
+        }
+    }
+};
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
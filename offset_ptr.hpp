@@ -0,0 +1,361 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_OFFSET_PTR_HPP)
+#define BIZWEN_OFFSET_PTR_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// assert
+#include <cassert>
+// size_t/ptrdiff_t/nullptr_t
+#include <cstddef>
+// uintptr_t
+#include <cstdint>
+// memcpy
+#include <cstring>
+// min/max
+#include <algorithm>
+// bit_width
+#include <bit>
+// strong_ordering
+#include <compare>
+// contiguous_iterator_tag
+#include <iterator>
+// addressof
+#include <memory>
+// bad_alloc
+#include <new>
+// is_void/is_convertible/remove_cv
+#include <type_traits>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+// 保存目标相对于自身地址的偏移的指针，整段内存映射到其它地址之后仍然有效
+// 偏移1表示空指针，因为对象自身的下一个字节不可能是有效的目标
+// 满足分配器对pointer的要求，并且是连续迭代器
+BIZWEN_EXPORT template <typename T>
+class offset_ptr
+{
+    ::std::ptrdiff_t offset_{1};
+
+    void set_(T *const p) noexcept
+    {
+        offset_ = p == nullptr ? ::std::ptrdiff_t(1)
+                               : static_cast<::std::ptrdiff_t>(reinterpret_cast<::std::uintptr_t>(p) -
+                                                               reinterpret_cast<::std::uintptr_t>(this));
+    }
+
+  public:
+    using element_type = T;
+    using value_type = ::std::remove_cv_t<T>;
+    using difference_type = ::std::ptrdiff_t;
+    using pointer = T *;
+    using reference = ::std::add_lvalue_reference_t<T>;
+    using iterator_category = ::std::random_access_iterator_tag;
+    using iterator_concept = ::std::contiguous_iterator_tag;
+
+    offset_ptr() noexcept = default;
+
+    offset_ptr(::std::nullptr_t) noexcept
+    {
+    }
+
+    offset_ptr(T *const p) noexcept
+    {
+        set_(p);
+    }
+
+    // 偏移相对于自身地址，因此复制时重新计算
+    offset_ptr(offset_ptr const &other) noexcept
+    {
+        set_(other.get());
+    }
+
+    template <typename U>
+        requires ::std::is_convertible_v<U *, T *>
+    offset_ptr(offset_ptr<U> const &other) noexcept
+    {
+        set_(other.get());
+    }
+
+    // 用于static_cast，例如void_pointer转换为pointer
+    template <typename U>
+        requires(!::std::is_convertible_v<U *, T *> && requires(U *u) { static_cast<T *>(u); })
+    explicit offset_ptr(offset_ptr<U> const &other) noexcept
+    {
+        set_(static_cast<T *>(other.get()));
+    }
+
+    offset_ptr &operator=(offset_ptr const &other) noexcept
+    {
+        set_(other.get());
+        return *this;
+    }
+
+    T *get() const noexcept
+    {
+        return offset_ == ::std::ptrdiff_t(1)
+                   ? nullptr
+                   : reinterpret_cast<T *>(reinterpret_cast<::std::uintptr_t>(this) +
+                                           static_cast<::std::uintptr_t>(offset_));
+    }
+
+    template <typename U = T>
+        requires(!::std::is_void_v<U>)
+    static offset_ptr pointer_to(U &r) noexcept
+    {
+        return offset_ptr(::std::addressof(r));
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return offset_ != ::std::ptrdiff_t(1);
+    }
+
+    template <typename U = T>
+        requires(!::std::is_void_v<U>)
+    U &operator*() const noexcept
+    {
+        assert(get() != nullptr);
+        return *get();
+    }
+
+    T *operator->() const noexcept
+    {
+        return get();
+    }
+
+    template <typename U = T>
+        requires(!::std::is_void_v<U>)
+    U &operator[](::std::ptrdiff_t const pos) const noexcept
+    {
+        return get()[pos];
+    }
+
+    offset_ptr &operator+=(::std::ptrdiff_t const pos) noexcept
+    {
+        set_(get() + pos);
+        return *this;
+    }
+
+    offset_ptr &operator-=(::std::ptrdiff_t const pos) noexcept
+    {
+        set_(get() - pos);
+        return *this;
+    }
+
+    offset_ptr &operator++() noexcept
+    {
+        return *this += ::std::ptrdiff_t(1);
+    }
+
+    offset_ptr operator++(int) noexcept
+    {
+        auto const temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    offset_ptr &operator--() noexcept
+    {
+        return *this -= ::std::ptrdiff_t(1);
+    }
+
+    offset_ptr operator--(int) noexcept
+    {
+        auto const temp = *this;
+        --*this;
+        return temp;
+    }
+
+    friend offset_ptr operator+(offset_ptr const &p, ::std::ptrdiff_t const pos) noexcept
+    {
+        return offset_ptr(p.get() + pos);
+    }
+
+    friend offset_ptr operator+(::std::ptrdiff_t const pos, offset_ptr const &p) noexcept
+    {
+        return offset_ptr(p.get() + pos);
+    }
+
+    friend offset_ptr operator-(offset_ptr const &p, ::std::ptrdiff_t const pos) noexcept
+    {
+        return offset_ptr(p.get() - pos);
+    }
+
+    friend ::std::ptrdiff_t operator-(offset_ptr const &lhs, offset_ptr const &rhs) noexcept
+    {
+        return lhs.get() - rhs.get();
+    }
+
+    friend bool operator==(offset_ptr const &lhs, offset_ptr const &rhs) noexcept
+    {
+        return lhs.get() == rhs.get();
+    }
+
+    friend bool operator==(offset_ptr const &p, ::std::nullptr_t) noexcept
+    {
+        return !p;
+    }
+
+    friend ::std::strong_ordering operator<=>(offset_ptr const &lhs, offset_ptr const &rhs) noexcept
+    {
+        return ::std::compare_three_way{}(lhs.get(), rhs.get());
+    }
+};
+
+// 位于一段内存开头的分配器状态，管理这段内存的其余部分
+// 所有位置都保存为相对于自身的偏移，因此整段内存可以映射到任意地址
+// 按2的幂分级，每级一个空闲链表，空闲块的前8字节保存下一个空闲块的偏移，新的内存从末尾按级别大小（最多一页）对齐分配
+// deque的块大小固定，释放的块总是被同级别的分配重用；不是线程安全的
+BIZWEN_EXPORT class offset_arena
+{
+    static constexpr ::std::size_t classes_ = 64u;
+    static constexpr ::std::size_t min_size_ = 16u;
+    static constexpr ::std::size_t max_align_ = 4096u;
+
+    ::std::size_t capacity_;
+    ::std::size_t used_;
+    // 0表示链表为空
+    ::std::size_t free_[classes_]{};
+
+    ::std::byte *at_(::std::size_t const offset) noexcept
+    {
+        return reinterpret_cast<::std::byte *>(this) + offset;
+    }
+
+    static ::std::size_t class_of_(::std::size_t const bytes) noexcept
+    {
+        return static_cast<::std::size_t>(::std::bit_width(bytes < min_size_ ? min_size_ - 1u : bytes - 1u));
+    }
+
+  public:
+    // capacity是包括arena自身在内的整段内存的字节数
+    explicit offset_arena(::std::size_t const capacity) noexcept : capacity_(capacity), used_(sizeof(offset_arena))
+    {
+    }
+
+    offset_arena(offset_arena const &) = delete;
+
+    offset_arena &operator=(offset_arena const &) = delete;
+
+    ::std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    // 从未分配过的字节数
+    ::std::size_t unused() const noexcept
+    {
+        return capacity_ - used_;
+    }
+
+    void *allocate(::std::size_t const bytes, ::std::size_t const align)
+    {
+        assert(align <= max_align_);
+        if (bytes >= capacity_)
+        {
+            throw ::std::bad_alloc{};
+        }
+        auto const c = class_of_(bytes);
+        if (auto const head = free_[c])
+        {
+            ::std::size_t next;
+            ::std::memcpy(&next, at_(head), sizeof(next));
+            free_[c] = next;
+            return at_(head);
+        }
+        auto const size = ::std::size_t(1) << c;
+        auto const alignment = (::std::max)(align, (::std::min)(size, max_align_));
+        auto const address = reinterpret_cast<::std::uintptr_t>(at_(used_));
+        auto const offset = used_ + (alignment - address % alignment) % alignment;
+        if (offset > capacity_ || capacity_ - offset < size)
+        {
+            throw ::std::bad_alloc{};
+        }
+        used_ = offset + size;
+        return at_(offset);
+    }
+
+    void deallocate(void *const p, ::std::size_t const bytes) noexcept
+    {
+        auto const c = class_of_(bytes);
+        auto const offset = static_cast<::std::size_t>(static_cast<::std::byte *>(p) - at_(0u));
+        ::std::memcpy(p, &free_[c], sizeof(free_[c]));
+        free_[c] = offset;
+    }
+};
+
+// 从offset_arena分配的分配器，pointer是offset_ptr
+// 分配器本身也只保存offset_ptr，因此可以和容器一起放在arena管理的内存中
+BIZWEN_EXPORT template <typename T>
+class arena_allocator
+{
+    offset_ptr<offset_arena> arena_{};
+
+  public:
+    using value_type = T;
+    using pointer = offset_ptr<T>;
+    using const_pointer = offset_ptr<T const>;
+    using void_pointer = offset_ptr<void>;
+    using const_void_pointer = offset_ptr<void const>;
+    using size_type = ::std::size_t;
+    using difference_type = ::std::ptrdiff_t;
+    using propagate_on_container_copy_assignment = ::std::true_type;
+    using propagate_on_container_move_assignment = ::std::true_type;
+    using propagate_on_container_swap = ::std::true_type;
+    using is_always_equal = ::std::false_type;
+
+    arena_allocator() noexcept = default;
+
+    explicit arena_allocator(offset_arena *const arena) noexcept : arena_(arena)
+    {
+    }
+
+    template <typename U>
+    arena_allocator(arena_allocator<U> const &other) noexcept : arena_(other.arena())
+    {
+    }
+
+    offset_arena *arena() const noexcept
+    {
+        return arena_.get();
+    }
+
+    pointer allocate(::std::size_t const n)
+    {
+        if (n > ::std::size_t(-1) / sizeof(T))
+        {
+            throw ::std::bad_alloc{};
+        }
+        return pointer(static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T))));
+    }
+
+    void deallocate(pointer const p, ::std::size_t const n) noexcept
+    {
+        arena_->deallocate(p.get(), n * sizeof(T));
+    }
+
+    template <typename U>
+    friend bool operator==(arena_allocator const &lhs, arena_allocator<U> const &rhs) noexcept
+    {
+        return lhs.arena() == rhs.arena();
+    }
+};
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
@@ -0,0 +1,317 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_PARALLEL_HPP)
+#define BIZWEN_PARALLEL_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// deque
+#include "./deque.hpp"
+// algorithm_detail
+#include "./algorithm.hpp"
+// assert
+#include <cassert>
+// size_t
+#include <cstddef>
+// min/ranges::transform/for_each
+#include <algorithm>
+// atomic
+#include <atomic>
+// condition_variable
+#include <condition_variable>
+#if defined(__cpp_lib_execution)
+// is_execution_policy
+#include <execution>
+#endif
+// plus
+#include <functional>
+// mutex/unique_lock/lock_guard
+#include <mutex>
+// iota
+#include <numeric>
+// optional
+#include <optional>
+// thread
+#include <thread>
+// remove_cvref/invoke_result
+#include <type_traits>
+// move/forward
+#include <utility>
+// vector
+#include <vector>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+namespace parallel
+{
+// 固定数量线程的线程池
+// bulk(n, f)并行调用f(0)到f(n-1)并等待全部完成，调用线程也参与执行
+// 任务按序号逐个领取，因此负载不均匀时也能平衡
+// 和执行策略一样，f抛出异常时调用std::terminate
+BIZWEN_EXPORT class thread_pool
+{
+    ::std::mutex bulk_mutex_{};
+    ::std::mutex mutex_{};
+    ::std::condition_variable start_{};
+    ::std::condition_variable done_{};
+    ::std::vector<::std::thread> threads_{};
+    // 当前任务，由mutex_保护发布
+    void *context_{};
+    void (*invoke_)(void *, ::std::size_t) noexcept {};
+    ::std::size_t count_{};
+    ::std::atomic<::std::size_t> next_{};
+    ::std::size_t generation_{};
+    ::std::size_t active_{};
+    bool stop_{};
+
+    void run_() noexcept
+    {
+        for (auto i = next_.fetch_add(::std::size_t(1), ::std::memory_order_relaxed); i < count_;
+             i = next_.fetch_add(::std::size_t(1), ::std::memory_order_relaxed))
+        {
+            invoke_(context_, i);
+        }
+    }
+
+    void work_() noexcept
+    {
+        auto seen = ::std::size_t(0);
+        ::std::unique_lock lock(mutex_);
+        for (;;)
+        {
+            start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_)
+            {
+                return;
+            }
+            seen = generation_;
+            lock.unlock();
+            run_();
+            lock.lock();
+            if (--active_ == ::std::size_t(0))
+            {
+                done_.notify_one();
+            }
+        }
+    }
+
+  public:
+    // threads包括调用bulk的线程
+    explicit thread_pool(::std::size_t const threads = ::std::thread::hardware_concurrency())
+    {
+        auto const workers = threads > ::std::size_t(1) ? threads - ::std::size_t(1) : ::std::size_t(0);
+        threads_.reserve(workers);
+        for (auto i = ::std::size_t(0); i != workers; ++i)
+        {
+            threads_.emplace_back([this] { work_(); });
+        }
+    }
+
+    thread_pool(thread_pool const &) = delete;
+
+    thread_pool &operator=(thread_pool const &) = delete;
+
+    ~thread_pool()
+    {
+        {
+            ::std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (auto &t : threads_)
+        {
+            t.join();
+        }
+    }
+
+    ::std::size_t concurrency() const noexcept
+    {
+        return threads_.size() + ::std::size_t(1);
+    }
+
+    template <typename F>
+    void bulk(::std::size_t const count, F &&f)
+    {
+        if (count == ::std::size_t(0))
+        {
+            return;
+        }
+        // 同一时间只执行一个bulk
+        ::std::lock_guard bulk_lock(bulk_mutex_);
+        {
+            ::std::lock_guard lock(mutex_);
+            context_ = ::std::addressof(f);
+            invoke_ = [](void *const context, ::std::size_t const i) noexcept {
+                (*static_cast<::std::remove_reference_t<F> *>(context))(i);
+            };
+            count_ = count;
+            next_.store(::std::size_t(0), ::std::memory_order_relaxed);
+            active_ = threads_.size();
+            ++generation_;
+        }
+        start_.notify_all();
+        run_();
+        ::std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] { return active_ == ::std::size_t(0); });
+    }
+};
+
+namespace parallel_detail
+{
+// 具有bulk成员函数的线程池
+template <typename Executor>
+concept thread_pool_like = requires(Executor &ex, void (*f)(::std::size_t)) { ex.bulk(::std::size_t(0), f); };
+
+#if defined(__cpp_lib_execution)
+// 执行策略或者线程池
+template <typename Executor>
+concept executor = ::std::is_execution_policy_v<::std::remove_cvref_t<Executor>> || thread_pool_like<Executor>;
+#else
+// 标准库不支持执行策略时只支持线程池
+template <typename Executor>
+concept executor = thread_pool_like<Executor>;
+#endif
+
+template <typename Executor, typename F>
+inline void bulk(Executor &&ex, ::std::size_t const count, F &&f)
+{
+#if defined(__cpp_lib_execution)
+    if constexpr (::std::is_execution_policy_v<::std::remove_cvref_t<Executor>>)
+    {
+        // C++17并行算法需要前向迭代器，因此不能使用iota_view
+        ::std::vector<::std::size_t> indices(count);
+        ::std::iota(indices.begin(), indices.end(), ::std::size_t(0));
+        ::std::for_each(::std::forward<Executor>(ex), indices.begin(), indices.end(),
+                        [&f](::std::size_t const i) { f(i); });
+    }
+    else
+#endif
+    {
+        ex.bulk(count, f);
+    }
+}
+
+} // namespace parallel_detail
+
+// 每个桶是一个任务，任务内部直接遍历指针
+BIZWEN_EXPORT template <typename Executor, typename T, typename Alloc, typename F>
+    requires parallel_detail::executor<Executor>
+inline void for_each(Executor &&ex, deque<T, Alloc> &d, F f)
+{
+    auto buckets = d.buckets();
+    parallel_detail::bulk(::std::forward<Executor>(ex), static_cast<::std::size_t>(buckets.size()),
+                          [&](::std::size_t const i) {
+                              for (auto &e : buckets.at(i))
+                              {
+                                  f(e);
+                              }
+                          });
+}
+
+BIZWEN_EXPORT template <typename Executor, typename T, typename Alloc, typename F>
+    requires parallel_detail::executor<Executor>
+inline void for_each(Executor &&ex, deque<T, Alloc> const &d, F f)
+{
+    auto buckets = d.buckets();
+    parallel_detail::bulk(::std::forward<Executor>(ex), static_cast<::std::size_t>(buckets.size()),
+                          [&](::std::size_t const i) {
+                              for (auto const &e : buckets.at(i))
+                              {
+                                  f(e);
+                              }
+                          });
+}
+
+// 将f(src[i])写入dst[i]，dst的大小必须不小于src
+// 两个deque的块布局不同，任务按dst的桶划分，每个任务从src中对应的位置开始逐桶读取
+// src和dst可以是同一个deque
+BIZWEN_EXPORT template <typename Executor, typename T, typename A1, typename U, typename A2, typename F>
+    requires parallel_detail::executor<Executor>
+inline void transform(Executor &&ex, deque<T, A1> const &src, deque<U, A2> &dst, F f)
+{
+    assert(dst.size() >= src.size());
+    auto const size = static_cast<::std::size_t>(src.size());
+    if (size == ::std::size_t(0))
+    {
+        return;
+    }
+    auto src_buckets = src.buckets();
+    auto dst_buckets = dst.buckets();
+    auto const count = algorithm_detail::locate<U>(dst_buckets, size - ::std::size_t(1)).bucket + ::std::size_t(1);
+    parallel_detail::bulk(::std::forward<Executor>(ex), count, [&](::std::size_t const j) {
+        auto const pos = algorithm_detail::bucket_offset<U>(dst_buckets, j);
+        auto out = dst_buckets.at(j);
+        out = out.first((::std::min)(out.size(), size - pos));
+        auto [i, offset] = algorithm_detail::locate<T>(src_buckets, pos);
+        while (!out.empty())
+        {
+            auto const in = src_buckets.at(i).subspan(offset);
+            auto const n = (::std::min)(in.size(), out.size());
+            ::std::ranges::transform(in.first(n), out.begin(), f);
+            out = out.subspan(n);
+            ++i;
+            offset = ::std::size_t(0);
+        }
+    });
+}
+
+// 原地变换
+BIZWEN_EXPORT template <typename Executor, typename T, typename Alloc, typename F>
+    requires parallel_detail::executor<Executor>
+inline void transform(Executor &&ex, deque<T, Alloc> &d, F f)
+{
+    for_each(::std::forward<Executor>(ex), d, [&f](T &e) { e = f(e); });
+}
+
+// 要求op满足结合律和交换律，与std::reduce相同
+// 每个桶先各自归约，再由调用线程按顺序合并
+BIZWEN_EXPORT template <typename Executor, typename T, typename Alloc, typename U, typename Op = ::std::plus<>>
+    requires parallel_detail::executor<Executor>
+inline U reduce(Executor &&ex, deque<T, Alloc> const &d, U init, Op op = Op())
+{
+    auto buckets = d.buckets();
+    auto const count = static_cast<::std::size_t>(buckets.size());
+    ::std::vector<::std::optional<U>> partials(count);
+    parallel_detail::bulk(::std::forward<Executor>(ex), count, [&](::std::size_t const i) {
+        auto const bucket = buckets.at(i);
+        auto first = bucket.begin();
+        U acc = *first;
+        for (++first; first != bucket.end(); ++first)
+        {
+            acc = op(::std::move(acc), *first);
+        }
+        partials[i].emplace(::std::move(acc));
+    });
+    for (auto &p : partials)
+    {
+        init = op(::std::move(init), ::std::move(*p));
+    }
+    return init;
+}
+
+// 桶内排序和每层合并都并行执行，合并按合并路径划分为固定大小的任务
+BIZWEN_EXPORT template <typename Executor, typename T, typename Alloc, typename Comp = ::std::less<>>
+    requires parallel_detail::executor<Executor>
+inline void sort(Executor &&ex, deque<T, Alloc> &d, Comp comp = Comp())
+{
+    algorithm_detail::sort(d, comp, deque_detail::block_elements_v<T> * ::std::size_t(16),
+                           [&ex](::std::size_t const count, auto &&f) { parallel_detail::bulk(ex, count, f); });
+}
+} // namespace parallel
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
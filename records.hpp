@@ -0,0 +1,250 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_RECORDS_HPP)
+#define BIZWEN_RECORDS_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// deque
+#include "./deque.hpp"
+// assert
+#include <cassert>
+// size_t/ptrdiff_t
+#include <cstddef>
+// memchr
+#include <cstring>
+// min
+#include <algorithm>
+// default_sentinel_t/input_iterator_tag
+#include <iterator>
+// addressof
+#include <memory>
+// string
+#include <string>
+// string_view
+#include <string_view>
+// exchange/move
+#include <utility>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+// 把deque<char>按分隔符切分为记录的输入范围，记录不包含分隔符
+// 每个桶内用memchr查找分隔符，完全位于一个块中的记录直接返回指向块内的string_view，
+// 跨越块边界的记录复制到可重用的缓冲区中再返回
+// 已经越过的记录不逐个移除，处理完首块或者迭代结束时才一次性移除，移除只调整块指针
+// 末尾没有分隔符的不完整记录留在deque中，等待追加更多数据之后再次切分
+// 递增迭代器时不查找下一条记录，解引用或者与end比较时才查找，因此views::take等适配器不会多移除一条记录
+// 迭代期间不能修改deque，返回的string_view在迭代器递增之前有效
+BIZWEN_EXPORT template <typename Alloc>
+class record_splitter
+{
+    deque<char, Alloc> *deque_;
+    // 跨越块边界的记录
+    ::std::string scratch_{};
+    ::std::string_view current_{};
+    // 已经处理但尚未移除的字节数，都位于首块中
+    ::std::size_t consumed_{};
+    char delimiter_;
+    bool done_{};
+    // 已经越过current_，下一条记录尚未查找
+    bool stale_{};
+
+    void flush_() noexcept
+    {
+        if (deque_ == nullptr)
+        {
+            return;
+        }
+        deque_->erase(deque_->begin(), deque_->begin() + static_cast<::std::ptrdiff_t>(consumed_));
+        consumed_ = ::std::size_t(0);
+    }
+
+    // 当前记录位于scratch_中时需要指向新的scratch_
+    void take_(record_splitter &other) noexcept
+    {
+        auto const in_scratch = !other.scratch_.empty() && other.current_.data() == other.scratch_.data();
+        deque_ = ::std::exchange(other.deque_, nullptr);
+        scratch_ = ::std::move(other.scratch_);
+        current_ = in_scratch ? ::std::string_view(scratch_) : other.current_;
+        consumed_ = ::std::exchange(other.consumed_, ::std::size_t(0));
+        delimiter_ = other.delimiter_;
+        done_ = other.done_;
+        stale_ = other.stale_;
+    }
+
+    void refresh_()
+    {
+        if (stale_)
+        {
+            stale_ = false;
+            next_();
+        }
+    }
+
+    void next_()
+    {
+        auto buckets = deque_->buckets();
+        auto it = buckets.begin();
+        if (it == buckets.end())
+        {
+            done_ = true;
+            return;
+        }
+        auto const first = *it;
+        // 首块处理完毕
+        if (consumed_ == first.size())
+        {
+            flush_();
+            next_();
+            return;
+        }
+        auto const begin = first.data() + consumed_;
+        auto const rest = first.size() - consumed_;
+        if (auto const p = static_cast<char const *>(::std::memchr(begin, delimiter_, rest)))
+        {
+            auto const length = static_cast<::std::size_t>(p - begin);
+            current_ = ::std::string_view(begin, length);
+            consumed_ += length + ::std::size_t(1);
+            return;
+        }
+        // 在之后的块中查找，找到之后才复制
+        auto length = rest;
+        for (++it; it != buckets.end(); ++it)
+        {
+            auto const bucket = *it;
+            auto const p = static_cast<char const *>(::std::memchr(bucket.data(), delimiter_, bucket.size()));
+            if (p == nullptr)
+            {
+                length += bucket.size();
+                continue;
+            }
+            length += static_cast<::std::size_t>(p - bucket.data());
+            scratch_.clear();
+            for (auto const &s : buckets)
+            {
+                if (scratch_.size() == length)
+                {
+                    break;
+                }
+                auto const offset = scratch_.empty() ? consumed_ : ::std::size_t(0);
+                scratch_.append(s.data() + offset, (::std::min)(s.size() - offset, length - scratch_.size()));
+            }
+            current_ = scratch_;
+            // 记录已经复制，之前的块可以整块移除
+            consumed_ += length + ::std::size_t(1);
+            flush_();
+            return;
+        }
+        // 没有完整的记录
+        flush_();
+        done_ = true;
+    }
+
+  public:
+    class iterator
+    {
+        record_splitter *parent_{};
+
+      public:
+        using value_type = ::std::string_view;
+        using difference_type = ::std::ptrdiff_t;
+        using iterator_concept = ::std::input_iterator_tag;
+
+        iterator() noexcept = default;
+
+        explicit iterator(record_splitter *const parent) noexcept : parent_(parent)
+        {
+        }
+
+        ::std::string_view operator*() const
+        {
+            parent_->refresh_();
+            assert(!parent_->done_);
+            return parent_->current_;
+        }
+
+        iterator &operator++() noexcept
+        {
+            parent_->stale_ = true;
+            return *this;
+        }
+
+        void operator++(int) noexcept
+        {
+            ++*this;
+        }
+
+        bool operator==(::std::default_sentinel_t) const
+        {
+            parent_->refresh_();
+            return parent_->done_;
+        }
+    };
+
+    record_splitter(deque<char, Alloc> &d, char const delimiter) noexcept
+        : deque_(::std::addressof(d)), delimiter_(delimiter)
+    {
+    }
+
+    record_splitter(record_splitter const &) = delete;
+
+    record_splitter &operator=(record_splitter const &) = delete;
+
+    // 移动后原对象不再持有deque，之前得到的迭代器失效
+    // 使得record_splitter可以传给范围适配器，例如split_records(d) | ::std::views::take(n)
+    record_splitter(record_splitter &&other) noexcept : delimiter_(other.delimiter_)
+    {
+        take_(other);
+    }
+
+    record_splitter &operator=(record_splitter &&other) noexcept
+    {
+        if (this != ::std::addressof(other))
+        {
+            flush_();
+            take_(other);
+        }
+        return *this;
+    }
+
+    // 提前结束迭代时移除已经返回的记录
+    ~record_splitter()
+    {
+        flush_();
+    }
+
+    // 只能调用一次
+    iterator begin() noexcept
+    {
+        stale_ = true;
+        return iterator(this);
+    }
+
+    ::std::default_sentinel_t end() const noexcept
+    {
+        return ::std::default_sentinel;
+    }
+};
+
+BIZWEN_EXPORT template <typename Alloc>
+inline record_splitter<Alloc> split_records(deque<char, Alloc> &d, char const delimiter = '\n') noexcept
+{
+    return record_splitter<Alloc>(d, delimiter);
+}
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
@@ -0,0 +1,247 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_SERIALIZE_HPP)
+#define BIZWEN_SERIALIZE_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// deque
+#include "./deque.hpp"
+// size_t/byte
+#include <cstddef>
+// uint32_t/uint64_t
+#include <cstdint>
+// memcpy/memcmp
+#include <cstring>
+// min
+#include <algorithm>
+// array
+#include <array>
+// istream
+#include <istream>
+// ostream
+#include <ostream>
+// span
+#include <span>
+// runtime_error
+#include <stdexcept>
+// is_trivially_copyable
+#include <type_traits>
+// vector
+#include <vector>
+
+#if __has_include(<sys/uio.h>)
+// errno
+#include <cerrno>
+// system_error
+#include <system_error>
+// IOV_MAX
+#include <climits>
+// readv/writev/iovec
+#include <sys/uio.h>
+#endif
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+namespace serialize_detail
+{
+// 24字节的文件头：魔数、版本、元素大小和元素数量，使用本机字节序
+// 字节序不同时版本号不匹配，因此同样被拒绝
+inline constexpr ::std::array<char, 4> magic_v{'B', 'Z', 'D', 'Q'};
+inline constexpr ::std::uint32_t version_v = 1u;
+inline constexpr ::std::size_t header_size_v = 24u;
+
+template <typename T>
+inline ::std::array<::std::byte, header_size_v> make_header(::std::uint64_t const count) noexcept
+{
+    ::std::array<::std::byte, header_size_v> header{};
+    auto const element_size = static_cast<::std::uint64_t>(sizeof(T));
+    ::std::memcpy(header.data(), magic_v.data(), 4u);
+    ::std::memcpy(header.data() + 4, &version_v, 4u);
+    ::std::memcpy(header.data() + 8, &element_size, 8u);
+    ::std::memcpy(header.data() + 16, &count, 8u);
+    return header;
+}
+
+// 返回元素数量
+template <typename T>
+inline ::std::size_t parse_header(::std::array<::std::byte, header_size_v> const &header)
+{
+    ::std::uint32_t version{};
+    ::std::uint64_t element_size{};
+    ::std::uint64_t count{};
+    ::std::memcpy(&version, header.data() + 4, 4u);
+    ::std::memcpy(&element_size, header.data() + 8, 8u);
+    ::std::memcpy(&count, header.data() + 16, 8u);
+    if (::std::memcmp(header.data(), magic_v.data(), 4u) != 0 || version != version_v)
+    {
+        throw ::std::runtime_error("bizwen::read: not a deque file of a supported version");
+    }
+    if (element_size != sizeof(T))
+    {
+        throw ::std::runtime_error("bizwen::read: element size mismatch");
+    }
+    if (count > static_cast<::std::uint64_t>(::std::size_t(-1) / sizeof(T)))
+    {
+        throw ::std::length_error("bizwen::read: too many elements");
+    }
+    return static_cast<::std::size_t>(count);
+}
+
+#if __has_include(<sys/uio.h>)
+#if defined(IOV_MAX)
+inline constexpr ::std::size_t iov_max_v = IOV_MAX;
+#else
+inline constexpr ::std::size_t iov_max_v = 1024u;
+#endif
+
+// 一次readv/writev最多IOV_MAX个iovec，处理部分完成和EINTR
+template <bool write>
+inline void transfer(int const fd, ::std::span<::iovec> iov)
+{
+    while (!iov.empty())
+    {
+        auto const batch = static_cast<int>((::std::min)(iov.size(), iov_max_v));
+        auto const result = write ? ::writev(fd, iov.data(), batch) : ::readv(fd, iov.data(), batch);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw ::std::system_error(errno, ::std::generic_category(), write ? "bizwen::write" : "bizwen::read");
+        }
+        if (result == 0)
+        {
+            throw ::std::runtime_error(write ? "bizwen::write: nothing written" : "bizwen::read: unexpected end of file");
+        }
+        for (auto done = static_cast<::std::size_t>(result); done != ::std::size_t(0);)
+        {
+            if (done >= iov.front().iov_len)
+            {
+                done -= iov.front().iov_len;
+                iov = iov.subspan(1u);
+            }
+            else
+            {
+                iov.front().iov_base = static_cast<::std::byte *>(iov.front().iov_base) + done;
+                iov.front().iov_len -= done;
+                done = ::std::size_t(0);
+            }
+        }
+    }
+}
+
+// 把每个桶作为一个iovec，每攒满IOV_MAX个提交一次
+template <bool write, typename Buckets>
+inline void transfer_buckets(int const fd, ::std::span<::std::byte> const header, Buckets &&buckets)
+{
+    ::std::vector<::iovec> iov{};
+    iov.reserve(iov_max_v);
+    if (!header.empty())
+    {
+        iov.push_back(::iovec{header.data(), header.size()});
+    }
+    for (auto const bucket : buckets)
+    {
+        if (iov.size() == iov_max_v)
+        {
+            transfer<write>(fd, iov);
+            iov.clear();
+        }
+        iov.push_back(::iovec{const_cast<void *>(static_cast<void const *>(bucket.data())), bucket.size_bytes()});
+    }
+    transfer<write>(fd, iov);
+}
+#endif
+} // namespace serialize_detail
+
+// 文件头之后依次写入每个桶的字节
+// 流进入错误状态时抛出异常，不再写入之后的桶
+BIZWEN_EXPORT template <typename T, typename Alloc>
+    requires ::std::is_trivially_copyable_v<T>
+inline void write(::std::ostream &os, deque<T, Alloc> const &d)
+{
+    auto const header = serialize_detail::make_header<T>(static_cast<::std::uint64_t>(d.size()));
+    if (!os.write(reinterpret_cast<char const *>(header.data()), static_cast<::std::streamsize>(header.size())))
+    {
+        throw ::std::runtime_error("bizwen::write: stream error");
+    }
+    for (auto const bucket : d.buckets())
+    {
+        if (!os.write(reinterpret_cast<char const *>(bucket.data()),
+                      static_cast<::std::streamsize>(bucket.size_bytes())))
+        {
+            throw ::std::runtime_error("bizwen::write: stream error");
+        }
+    }
+}
+
+// 替换d的元素，元素直接读入块中，不逐个构造
+// 文件头无效或者数据不完整时抛出异常，此时d为空
+BIZWEN_EXPORT template <typename T, typename Alloc>
+    requires ::std::is_trivially_copyable_v<T>
+inline void read(::std::istream &is, deque<T, Alloc> &d)
+{
+    d.clear();
+    ::std::array<::std::byte, serialize_detail::header_size_v> header{};
+    if (!is.read(reinterpret_cast<char *>(header.data()), static_cast<::std::streamsize>(header.size())))
+    {
+        throw ::std::runtime_error("bizwen::read: unexpected end of file");
+    }
+    auto const count = serialize_detail::parse_header<T>(header);
+    d.append_and_overwrite(count, [&is, count](auto buckets) {
+        for (auto const bucket : buckets)
+        {
+            if (!is.read(reinterpret_cast<char *>(bucket.data()),
+                         static_cast<::std::streamsize>(bucket.size_bytes())))
+            {
+                throw ::std::runtime_error("bizwen::read: unexpected end of file");
+            }
+        }
+        return count;
+    });
+}
+
+#if __has_include(<sys/uio.h>)
+// 文件头和所有的桶通过writev写入，每次最多IOV_MAX个桶
+BIZWEN_EXPORT template <typename T, typename Alloc>
+    requires ::std::is_trivially_copyable_v<T>
+inline void write(int const fd, deque<T, Alloc> const &d)
+{
+    auto header = serialize_detail::make_header<T>(static_cast<::std::uint64_t>(d.size()));
+    serialize_detail::transfer_buckets<true>(fd, header, d.buckets());
+}
+
+// 参考read(istream&, deque&)，元素通过readv直接读入块中
+BIZWEN_EXPORT template <typename T, typename Alloc>
+    requires ::std::is_trivially_copyable_v<T>
+inline void read(int const fd, deque<T, Alloc> &d)
+{
+    d.clear();
+    ::std::array<::std::byte, serialize_detail::header_size_v> header{};
+    serialize_detail::transfer_buckets<false>(fd, header, ::std::span<::std::span<T>>{});
+    auto const count = serialize_detail::parse_header<T>(header);
+    d.append_and_overwrite(count, [fd, count](auto buckets) {
+        serialize_detail::transfer_buckets<false>(fd, {}, buckets);
+        return count;
+    });
+}
+#endif
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
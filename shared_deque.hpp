@@ -0,0 +1,387 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_SHARED_DEQUE_HPP)
+#define BIZWEN_SHARED_DEQUE_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// deque
+#include "./deque.hpp"
+// offset_arena/arena_allocator
+#include "./offset_ptr.hpp"
+// errno
+#include <cerrno>
+// size_t/ptrdiff_t/byte
+#include <cstddef>
+// uint32_t/uint64_t/uintptr_t
+#include <cstdint>
+// atomic_ref
+#include <atomic>
+// steady_clock/seconds
+#include <chrono>
+// placement new
+#include <new>
+// runtime_error
+#include <stdexcept>
+// system_error
+#include <system_error>
+// this_thread::yield
+#include <thread>
+// is_trivially_copyable
+#include <type_traits>
+// exchange
+#include <utility>
+
+// O_CREAT/O_EXCL/O_RDWR
+#include <fcntl.h>
+// pthread_mutex_t/pthread_cond_t
+#include <pthread.h>
+// shm_open/shm_unlink/mmap/munmap
+#include <sys/mman.h>
+// fstat
+#include <sys/stat.h>
+// ftruncate/close
+#include <unistd.h>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+// 通过POSIX共享内存在多个进程之间共享的deque，元素必须可平凡复制
+// 共享内存开头是进程间互斥量和条件变量、deque对象和offset_arena，控制块和所有块都由arena分配，块指针都是offset_ptr
+// 每个进程可以把共享内存映射到不同的地址，deque对象中缓存的裸指针只对最后一个加锁的进程有效，
+// 因此lock()在加锁之后把它们修正到本进程的地址，只需要常数时间
+// 只能在持有锁时访问deque，引用和迭代器在解锁之后失效
+// 持有锁的进程退出时deque可能只修改了一半，无法修复，因此之后所有的lock()都抛出异常，需要remove之后重新创建
+BIZWEN_EXPORT template <typename T>
+    requires ::std::is_trivially_copyable_v<T>
+class shared_deque
+{
+  public:
+    using deque_type = deque<T, arena_allocator<T>>;
+
+  private:
+    struct segment_layout_
+    {
+        // 创建者初始化完成之后置为1
+        ::std::uint32_t ready;
+        ::std::uint32_t element_size;
+        ::std::uint64_t capacity;
+        // deque对象中的裸指针有效的地址
+        ::std::uint64_t base;
+        ::pthread_mutex_t mutex;
+        ::pthread_cond_t cond;
+        deque_type container;
+        // 必须是最后一个成员，它管理之后的全部内存
+        offset_arena arena;
+    };
+
+    segment_layout_ *segment_{};
+    ::std::size_t size_{};
+
+    [[noreturn]] static void throw_errno_(int const error, char const *const what)
+    {
+        throw ::std::system_error(error, ::std::generic_category(), what);
+    }
+
+    ::std::uint64_t base_() const noexcept
+    {
+        return static_cast<::std::uint64_t>(reinterpret_cast<::std::uintptr_t>(segment_));
+    }
+
+    void close_() noexcept
+    {
+        if (segment_ != nullptr)
+        {
+            ::munmap(segment_, size_);
+        }
+        segment_ = nullptr;
+    }
+
+    void map_(int const fd, ::std::size_t const size)
+    {
+        auto const p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED)
+        {
+            throw_errno_(errno, "bizwen::shared_deque: mmap");
+        }
+        segment_ = static_cast<segment_layout_ *>(p);
+        size_ = size;
+    }
+
+    void create_(int const fd, ::std::size_t capacity)
+    {
+        if (capacity < sizeof(segment_layout_) + ::std::size_t(65536))
+        {
+            capacity = sizeof(segment_layout_) + ::std::size_t(65536);
+        }
+        if (::ftruncate(fd, static_cast<::off_t>(capacity)) != 0)
+        {
+            throw_errno_(errno, "bizwen::shared_deque: ftruncate");
+        }
+        map_(fd, capacity);
+        auto const s = segment_;
+        s->element_size = static_cast<::std::uint32_t>(sizeof(T));
+        s->capacity = capacity;
+        s->base = base_();
+        ::pthread_mutexattr_t mutex_attr;
+        ::pthread_mutexattr_init(&mutex_attr);
+        ::pthread_mutexattr_setpshared(&mutex_attr, PTHREAD_PROCESS_SHARED);
+#if defined(__linux__)
+        // 持有锁的进程退出时，其它进程仍然可以加锁
+        ::pthread_mutexattr_setrobust(&mutex_attr, PTHREAD_MUTEX_ROBUST);
+#endif
+        ::pthread_mutex_init(&s->mutex, &mutex_attr);
+        ::pthread_mutexattr_destroy(&mutex_attr);
+        ::pthread_condattr_t cond_attr;
+        ::pthread_condattr_init(&cond_attr);
+        ::pthread_condattr_setpshared(&cond_attr, PTHREAD_PROCESS_SHARED);
+        ::pthread_cond_init(&s->cond, &cond_attr);
+        ::pthread_condattr_destroy(&cond_attr);
+        auto const arena_offset =
+            static_cast<::std::size_t>(reinterpret_cast<::std::byte *>(&s->arena) - reinterpret_cast<::std::byte *>(s));
+        auto const arena = ::new (static_cast<void *>(&s->arena)) offset_arena(capacity - arena_offset);
+        ::new (static_cast<void *>(&s->container)) deque_type(arena_allocator<T>(arena));
+        ::std::atomic_ref<::std::uint32_t>(s->ready).store(1u, ::std::memory_order_release);
+    }
+
+    [[noreturn]] static void throw_not_ready_()
+    {
+        throw ::std::runtime_error("bizwen::shared_deque: the creator did not initialize the segment");
+    }
+
+    // 等待创建者设置大小并完成初始化，创建者在此之前退出时超时抛出异常
+    void attach_(int const fd)
+    {
+        auto const deadline = ::std::chrono::steady_clock::now() + ::std::chrono::seconds(1);
+        struct ::stat st{};
+        for (;;)
+        {
+            if (::fstat(fd, &st) != 0)
+            {
+                throw_errno_(errno, "bizwen::shared_deque: fstat");
+            }
+            if (st.st_size != 0)
+            {
+                break;
+            }
+            if (::std::chrono::steady_clock::now() > deadline)
+            {
+                throw_not_ready_();
+            }
+            ::std::this_thread::yield();
+        }
+        map_(fd, static_cast<::std::size_t>(st.st_size));
+        while (::std::atomic_ref<::std::uint32_t>(segment_->ready).load(::std::memory_order_acquire) == 0u)
+        {
+            if (::std::chrono::steady_clock::now() > deadline)
+            {
+                throw_not_ready_();
+            }
+            ::std::this_thread::yield();
+        }
+        if (segment_->capacity != size_)
+        {
+            throw ::std::runtime_error("bizwen::shared_deque: not a shared deque segment");
+        }
+        if (segment_->element_size != sizeof(T))
+        {
+            throw ::std::runtime_error("bizwen::shared_deque: element size mismatch");
+        }
+    }
+
+    void open_(char const *const name, ::std::size_t const capacity)
+    {
+        auto create = true;
+        auto fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (fd == -1 && errno == EEXIST)
+        {
+            create = false;
+            fd = ::shm_open(name, O_RDWR | O_CLOEXEC, 0600);
+        }
+        if (fd == -1)
+        {
+            throw_errno_(errno, "bizwen::shared_deque: shm_open");
+        }
+        // 映射持有共享内存的引用
+        struct fd_guard
+        {
+            int fd;
+
+            ~fd_guard()
+            {
+                ::close(fd);
+            }
+        } guard{fd};
+        if (create)
+        {
+            // 初始化失败时删除名字，之后打开的进程可以重新创建
+            struct unlink_guard
+            {
+                char const *name;
+
+                ~unlink_guard()
+                {
+                    if (name != nullptr)
+                    {
+                        ::shm_unlink(name);
+                    }
+                }
+            } unlink{name};
+            create_(fd, capacity);
+            unlink.name = nullptr;
+        }
+        else
+        {
+            attach_(fd);
+        }
+    }
+
+  public:
+    // 持有锁并提供对deque的访问
+    class locked
+    {
+        shared_deque *parent_;
+
+        void rebase_() noexcept
+        {
+            auto const s = parent_->segment_;
+            auto const base = parent_->base_();
+            if (s->base != base)
+            {
+                s->container.rebase_(static_cast<::std::ptrdiff_t>(base - s->base));
+                s->base = base;
+            }
+        }
+
+      public:
+        // 之前持有锁的进程已经退出时返回EOWNERDEAD，deque可能处于任意一次修改（包括修正裸指针）的中途
+        // 不调用pthread_mutex_consistent，解锁之后互斥量不可恢复，此后加锁都返回ENOTRECOVERABLE
+        explicit locked(shared_deque *const parent) : parent_(parent)
+        {
+            auto const result = ::pthread_mutex_lock(&parent_->segment_->mutex);
+            if (result != 0)
+            {
+                if (result == EOWNERDEAD)
+                {
+                    ::pthread_mutex_unlock(&parent_->segment_->mutex);
+                }
+                throw_errno_(result, "bizwen::shared_deque: pthread_mutex_lock");
+            }
+            rebase_();
+        }
+
+        locked(locked const &) = delete;
+
+        locked &operator=(locked const &) = delete;
+
+        ~locked()
+        {
+            ::pthread_mutex_unlock(&parent_->segment_->mutex);
+        }
+
+        deque_type &operator*() const noexcept
+        {
+            return parent_->segment_->container;
+        }
+
+        deque_type *operator->() const noexcept
+        {
+            return &parent_->segment_->container;
+        }
+
+        // 释放锁并等待notify，返回时重新持有锁，抛出异常时也持有锁，由析构函数解锁
+        void wait()
+        {
+            auto const result = ::pthread_cond_wait(&parent_->segment_->cond, &parent_->segment_->mutex);
+            if (result != 0)
+            {
+                throw_errno_(result, "bizwen::shared_deque: pthread_cond_wait");
+            }
+            // 等待期间其它进程可能已经修改了deque中的裸指针
+            rebase_();
+        }
+
+        template <typename Pred>
+        void wait(Pred pred)
+        {
+            while (!pred())
+            {
+                wait();
+            }
+        }
+
+        // 唤醒所有进程中等待的线程
+        void notify_all() const noexcept
+        {
+            ::pthread_cond_broadcast(&parent_->segment_->cond);
+        }
+    };
+
+    // 打开名为name的共享内存，不存在时创建一个大小为capacity字节的共享内存，否则忽略capacity
+    shared_deque(char const *const name, ::std::size_t const capacity)
+    {
+        struct guard
+        {
+            shared_deque *self;
+
+            ~guard()
+            {
+                if (self != nullptr)
+                {
+                    self->close_();
+                }
+            }
+        } guard{this};
+        open_(name, capacity);
+        guard.self = nullptr;
+    }
+
+    shared_deque(shared_deque &&other) noexcept
+        : segment_(::std::exchange(other.segment_, nullptr)), size_(other.size_)
+    {
+    }
+
+    shared_deque &operator=(shared_deque &&other) noexcept
+    {
+        if (this != &other)
+        {
+            close_();
+            segment_ = ::std::exchange(other.segment_, nullptr);
+            size_ = other.size_;
+        }
+        return *this;
+    }
+
+    // 只解除映射，共享内存和其中的元素在remove之前一直存在
+    ~shared_deque()
+    {
+        close_();
+    }
+
+    locked lock()
+    {
+        return locked(this);
+    }
+
+    // 删除共享内存的名字，已经打开的shared_deque不受影响
+    static void remove(char const *const name) noexcept
+    {
+        ::shm_unlink(name);
+    }
+};
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
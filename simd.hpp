@@ -0,0 +1,762 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_SIMD_HPP)
+#define BIZWEN_SIMD_HPP
+
+// 定义BIZWEN_DEQUE_NO_SIMD以只使用标量实现
+#if !defined(BIZWEN_DEQUE_NO_SIMD) &&                                                                                  \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define BIZWEN_DEQUE_SIMD_X86
+#endif
+
+#if defined(BIZWEN_DEQUE_SIMD_X86)
+#if defined(__GNUC__) || defined(__clang__)
+#define BIZWEN_DEQUE_TARGET_AVX2 __attribute__((__target__("avx2")))
+#else
+#define BIZWEN_DEQUE_TARGET_AVX2
+#endif
+#endif
+
+#if !defined(BIZWEN_MODULE)
+
+// size_t
+#include <cstddef>
+// find/count
+#include <algorithm>
+// bit_cast/countr_zero/popcount
+#include <bit>
+// integral/floating_point/same_as
+#include <concepts>
+// conditional_t
+#include <type_traits>
+
+#if defined(BIZWEN_DEQUE_SIMD_X86)
+// SSE2/AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+// __cpuid/__cpuidex
+#include <intrin.h>
+#endif
+#endif
+
+#endif
+
+namespace bizwen
+{
+// 连续内存上的向量化比较和归约内核，供algorithm.hpp按桶调用
+// x86上SSE2是基线，AVX2在运行时检测，其他平台使用标量实现
+namespace simd_detail
+{
+// 比较相等与operator==一致的类型，浮点数使用浮点比较，因此NaN不等于自身
+template <typename T>
+concept vectorizable = (::std::integral<T> || ::std::same_as<T, float> || ::std::same_as<T, double>) &&
+                       (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+template <bool Eq, typename T>
+inline constexpr T const *find_scalar(T const *first, T const *const last, T const value) noexcept
+{
+    for (; first != last; ++first)
+    {
+        if ((*first == value) == Eq)
+        {
+            break;
+        }
+    }
+    return first;
+}
+
+template <typename T>
+inline constexpr ::std::size_t count_scalar(T const *first, T const *const last, T const value) noexcept
+{
+    auto count = ::std::size_t(0);
+    for (; first != last; ++first)
+    {
+        count += static_cast<::std::size_t>(*first == value);
+    }
+    return count;
+}
+
+template <typename T>
+inline constexpr T sum_scalar(T const *first, T const *const last) noexcept
+{
+    auto sum = T();
+    for (; first != last; ++first)
+    {
+        sum += *first;
+    }
+    return sum;
+}
+
+template <typename T>
+inline constexpr T dot_scalar(T const *a, T const *const last, T const *b) noexcept
+{
+    auto sum = T();
+    for (; a != last; ++a, ++b)
+    {
+        sum += *a * *b;
+    }
+    return sum;
+}
+
+// 调用者保证范围非空，并用首元素初始化min和max
+template <typename T>
+inline constexpr void minmax_scalar(T const *first, T const *const last, T &min, T &max) noexcept
+{
+    for (; first != last; ++first)
+    {
+        if (*first < min)
+        {
+            min = *first;
+        }
+        if (max < *first)
+        {
+            max = *first;
+        }
+    }
+}
+
+#if defined(BIZWEN_DEQUE_SIMD_X86)
+template <typename T>
+using lane_int_t = ::std::conditional_t<
+    sizeof(T) == 1, char,
+    ::std::conditional_t<sizeof(T) == 2, short, ::std::conditional_t<sizeof(T) == 4, int, long long>>>;
+
+template <typename T>
+inline __m128i set1_sse2(T const value) noexcept
+{
+    auto const v = ::std::bit_cast<lane_int_t<T>>(value);
+    if constexpr (sizeof(T) == 1)
+    {
+        return _mm_set1_epi8(v);
+    }
+    else if constexpr (sizeof(T) == 2)
+    {
+        return _mm_set1_epi16(v);
+    }
+    else if constexpr (sizeof(T) == 4)
+    {
+        return _mm_set1_epi32(v);
+    }
+    else
+    {
+        return _mm_set1_epi64x(v);
+    }
+}
+
+// 返回字节掩码，每个相等的元素贡献sizeof(T)个位
+template <typename T>
+inline unsigned eq_mask_sse2(__m128i const a, __m128i const b) noexcept
+{
+    __m128i r;
+    if constexpr (::std::same_as<T, float>)
+    {
+        r = _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    }
+    else if constexpr (::std::same_as<T, double>)
+    {
+        r = _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    }
+    else if constexpr (sizeof(T) == 1)
+    {
+        r = _mm_cmpeq_epi8(a, b);
+    }
+    else if constexpr (sizeof(T) == 2)
+    {
+        r = _mm_cmpeq_epi16(a, b);
+    }
+    else if constexpr (sizeof(T) == 4)
+    {
+        r = _mm_cmpeq_epi32(a, b);
+    }
+    else
+    {
+        // SSE2没有64位比较，两个32位半部都相等时才相等
+        auto const t = _mm_cmpeq_epi32(a, b);
+        r = _mm_and_si128(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+    return static_cast<unsigned>(_mm_movemask_epi8(r));
+}
+
+template <bool Eq, typename T>
+inline T const *find_sse2(T const *first, T const *const last, T const value) noexcept
+{
+    constexpr auto lanes = ::std::size_t(16) / sizeof(T);
+    auto const needle = set1_sse2(value);
+    for (; static_cast<::std::size_t>(last - first) >= lanes; first += lanes)
+    {
+        auto mask = eq_mask_sse2<T>(_mm_loadu_si128(reinterpret_cast<__m128i const *>(first)), needle);
+        if constexpr (!Eq)
+        {
+            mask ^= 0xFFFFu;
+        }
+        if (mask != 0u)
+        {
+            return first + ::std::countr_zero(mask) / sizeof(T);
+        }
+    }
+    return find_scalar<Eq>(first, last, value);
+}
+
+template <typename T>
+inline ::std::size_t count_sse2(T const *first, T const *const last, T const value) noexcept
+{
+    constexpr auto lanes = ::std::size_t(16) / sizeof(T);
+    auto const needle = set1_sse2(value);
+    auto bits = ::std::size_t(0);
+    for (; static_cast<::std::size_t>(last - first) >= lanes; first += lanes)
+    {
+        bits += static_cast<::std::size_t>(
+            ::std::popcount(eq_mask_sse2<T>(_mm_loadu_si128(reinterpret_cast<__m128i const *>(first)), needle)));
+    }
+    return bits / sizeof(T) + count_scalar(first, last, value);
+}
+
+template <typename T>
+BIZWEN_DEQUE_TARGET_AVX2 inline __m256i set1_avx2(T const value) noexcept
+{
+    auto const v = ::std::bit_cast<lane_int_t<T>>(value);
+    if constexpr (sizeof(T) == 1)
+    {
+        return _mm256_set1_epi8(v);
+    }
+    else if constexpr (sizeof(T) == 2)
+    {
+        return _mm256_set1_epi16(v);
+    }
+    else if constexpr (sizeof(T) == 4)
+    {
+        return _mm256_set1_epi32(v);
+    }
+    else
+    {
+        return _mm256_set1_epi64x(v);
+    }
+}
+
+template <typename T>
+BIZWEN_DEQUE_TARGET_AVX2 inline unsigned eq_mask_avx2(__m256i const a, __m256i const b) noexcept
+{
+    __m256i r;
+    if constexpr (::std::same_as<T, float>)
+    {
+        r = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+    }
+    else if constexpr (::std::same_as<T, double>)
+    {
+        r = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+    }
+    else if constexpr (sizeof(T) == 1)
+    {
+        r = _mm256_cmpeq_epi8(a, b);
+    }
+    else if constexpr (sizeof(T) == 2)
+    {
+        r = _mm256_cmpeq_epi16(a, b);
+    }
+    else if constexpr (sizeof(T) == 4)
+    {
+        r = _mm256_cmpeq_epi32(a, b);
+    }
+    else
+    {
+        r = _mm256_cmpeq_epi64(a, b);
+    }
+    return static_cast<unsigned>(_mm256_movemask_epi8(r));
+}
+
+template <bool Eq, typename T>
+BIZWEN_DEQUE_TARGET_AVX2 inline T const *find_avx2(T const *first, T const *const last, T const value) noexcept
+{
+    constexpr auto lanes = ::std::size_t(32) / sizeof(T);
+    auto const needle = set1_avx2(value);
+    for (; static_cast<::std::size_t>(last - first) >= lanes; first += lanes)
+    {
+        auto mask = eq_mask_avx2<T>(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(first)), needle);
+        if constexpr (!Eq)
+        {
+            mask = ~mask;
+        }
+        if (mask != 0u)
+        {
+            return first + ::std::countr_zero(mask) / sizeof(T);
+        }
+    }
+    return find_scalar<Eq>(first, last, value);
+}
+
+template <typename T>
+BIZWEN_DEQUE_TARGET_AVX2 inline ::std::size_t count_avx2(T const *first, T const *const last, T const value) noexcept
+{
+    constexpr auto lanes = ::std::size_t(32) / sizeof(T);
+    auto const needle = set1_avx2(value);
+    auto bits = ::std::size_t(0);
+    for (; static_cast<::std::size_t>(last - first) >= lanes; first += lanes)
+    {
+        bits += static_cast<::std::size_t>(
+            ::std::popcount(eq_mask_avx2<T>(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(first)), needle)));
+    }
+    return bits / sizeof(T) + count_scalar(first, last, value);
+}
+
+// 浮点向量的基本操作，使归约内核可以同时用于float和double
+template <typename T>
+struct sse2_ops;
+
+template <>
+struct sse2_ops<float>
+{
+    using vec = __m128;
+    static constexpr ::std::size_t lanes = ::std::size_t(4);
+
+    static vec zero() noexcept
+    {
+        return _mm_setzero_ps();
+    }
+
+    static vec set1(float const v) noexcept
+    {
+        return _mm_set1_ps(v);
+    }
+
+    static vec load(float const *const p) noexcept
+    {
+        return _mm_loadu_ps(p);
+    }
+
+    static void store(float *const p, vec const v) noexcept
+    {
+        _mm_storeu_ps(p, v);
+    }
+
+    static vec add(vec const a, vec const b) noexcept
+    {
+        return _mm_add_ps(a, b);
+    }
+
+    static vec mul(vec const a, vec const b) noexcept
+    {
+        return _mm_mul_ps(a, b);
+    }
+
+    static vec min(vec const a, vec const b) noexcept
+    {
+        return _mm_min_ps(a, b);
+    }
+
+    static vec max(vec const a, vec const b) noexcept
+    {
+        return _mm_max_ps(a, b);
+    }
+};
+
+template <>
+struct sse2_ops<double>
+{
+    using vec = __m128d;
+    static constexpr ::std::size_t lanes = ::std::size_t(2);
+
+    static vec zero() noexcept
+    {
+        return _mm_setzero_pd();
+    }
+
+    static vec set1(double const v) noexcept
+    {
+        return _mm_set1_pd(v);
+    }
+
+    static vec load(double const *const p) noexcept
+    {
+        return _mm_loadu_pd(p);
+    }
+
+    static void store(double *const p, vec const v) noexcept
+    {
+        _mm_storeu_pd(p, v);
+    }
+
+    static vec add(vec const a, vec const b) noexcept
+    {
+        return _mm_add_pd(a, b);
+    }
+
+    static vec mul(vec const a, vec const b) noexcept
+    {
+        return _mm_mul_pd(a, b);
+    }
+
+    static vec min(vec const a, vec const b) noexcept
+    {
+        return _mm_min_pd(a, b);
+    }
+
+    static vec max(vec const a, vec const b) noexcept
+    {
+        return _mm_max_pd(a, b);
+    }
+};
+
+template <typename T>
+struct avx2_ops;
+
+template <>
+struct avx2_ops<float>
+{
+    using vec = __m256;
+    static constexpr ::std::size_t lanes = ::std::size_t(8);
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec zero() noexcept
+    {
+        return _mm256_setzero_ps();
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec set1(float const v) noexcept
+    {
+        return _mm256_set1_ps(v);
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec load(float const *const p) noexcept
+    {
+        return _mm256_loadu_ps(p);
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static void store(float *const p, vec const v) noexcept
+    {
+        _mm256_storeu_ps(p, v);
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec add(vec const a, vec const b) noexcept
+    {
+        return _mm256_add_ps(a, b);
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec mul(vec const a, vec const b) noexcept
+    {
+        return _mm256_mul_ps(a, b);
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec min(vec const a, vec const b) noexcept
+    {
+        return _mm256_min_ps(a, b);
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec max(vec const a, vec const b) noexcept
+    {
+        return _mm256_max_ps(a, b);
+    }
+};
+
+template <>
+struct avx2_ops<double>
+{
+    using vec = __m256d;
+    static constexpr ::std::size_t lanes = ::std::size_t(4);
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec zero() noexcept
+    {
+        return _mm256_setzero_pd();
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec set1(double const v) noexcept
+    {
+        return _mm256_set1_pd(v);
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec load(double const *const p) noexcept
+    {
+        return _mm256_loadu_pd(p);
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static void store(double *const p, vec const v) noexcept
+    {
+        _mm256_storeu_pd(p, v);
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec add(vec const a, vec const b) noexcept
+    {
+        return _mm256_add_pd(a, b);
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec mul(vec const a, vec const b) noexcept
+    {
+        return _mm256_mul_pd(a, b);
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec min(vec const a, vec const b) noexcept
+    {
+        return _mm256_min_pd(a, b);
+    }
+
+    BIZWEN_DEQUE_TARGET_AVX2 static vec max(vec const a, vec const b) noexcept
+    {
+        return _mm256_max_pd(a, b);
+    }
+};
+
+// 四个独立的向量累加器，隐藏加法的延迟
+template <typename T>
+inline T sum_sse2(T const *first, T const *const last) noexcept
+{
+    using ops = sse2_ops<T>;
+    constexpr auto lanes = ops::lanes;
+    auto a0 = ops::zero(), a1 = ops::zero(), a2 = ops::zero(), a3 = ops::zero();
+    for (; static_cast<::std::size_t>(last - first) >= lanes * 4u; first += lanes * 4u)
+    {
+        a0 = ops::add(a0, ops::load(first));
+        a1 = ops::add(a1, ops::load(first + lanes));
+        a2 = ops::add(a2, ops::load(first + lanes * 2u));
+        a3 = ops::add(a3, ops::load(first + lanes * 3u));
+    }
+    T tmp[lanes];
+    ops::store(tmp, ops::add(ops::add(a0, a1), ops::add(a2, a3)));
+    auto sum = T();
+    for (auto const e : tmp)
+    {
+        sum += e;
+    }
+    return sum + sum_scalar(first, last);
+}
+
+template <typename T>
+inline T dot_sse2(T const *a, T const *const last, T const *b) noexcept
+{
+    using ops = sse2_ops<T>;
+    constexpr auto lanes = ops::lanes;
+    auto a0 = ops::zero(), a1 = ops::zero(), a2 = ops::zero(), a3 = ops::zero();
+    for (; static_cast<::std::size_t>(last - a) >= lanes * 4u; a += lanes * 4u, b += lanes * 4u)
+    {
+        a0 = ops::add(a0, ops::mul(ops::load(a), ops::load(b)));
+        a1 = ops::add(a1, ops::mul(ops::load(a + lanes), ops::load(b + lanes)));
+        a2 = ops::add(a2, ops::mul(ops::load(a + lanes * 2u), ops::load(b + lanes * 2u)));
+        a3 = ops::add(a3, ops::mul(ops::load(a + lanes * 3u), ops::load(b + lanes * 3u)));
+    }
+    T tmp[lanes];
+    ops::store(tmp, ops::add(ops::add(a0, a1), ops::add(a2, a3)));
+    auto sum = T();
+    for (auto const e : tmp)
+    {
+        sum += e;
+    }
+    return sum + dot_scalar(a, last, b);
+}
+
+template <typename T>
+inline void minmax_sse2(T const *first, T const *const last, T &min, T &max) noexcept
+{
+    using ops = sse2_ops<T>;
+    constexpr auto lanes = ops::lanes;
+    if (static_cast<::std::size_t>(last - first) >= lanes * 2u)
+    {
+        auto l0 = ops::set1(min), l1 = l0, h0 = ops::set1(max), h1 = h0;
+        for (; static_cast<::std::size_t>(last - first) >= lanes * 2u; first += lanes * 2u)
+        {
+            auto const v0 = ops::load(first);
+            auto const v1 = ops::load(first + lanes);
+            l0 = ops::min(l0, v0);
+            l1 = ops::min(l1, v1);
+            h0 = ops::max(h0, v0);
+            h1 = ops::max(h1, v1);
+        }
+        T lo[lanes];
+        T hi[lanes];
+        ops::store(lo, ops::min(l0, l1));
+        ops::store(hi, ops::max(h0, h1));
+        minmax_scalar(lo, lo + lanes, min, max);
+        minmax_scalar(hi, hi + lanes, min, max);
+    }
+    minmax_scalar(first, last, min, max);
+}
+
+// AVX2版本需要单独定义，模板内核带有target属性时SSE2版本也会被编译为AVX2指令
+template <typename T>
+BIZWEN_DEQUE_TARGET_AVX2 inline T sum_avx2(T const *first, T const *const last) noexcept
+{
+    using ops = avx2_ops<T>;
+    constexpr auto lanes = ops::lanes;
+    auto a0 = ops::zero(), a1 = ops::zero(), a2 = ops::zero(), a3 = ops::zero();
+    for (; static_cast<::std::size_t>(last - first) >= lanes * 4u; first += lanes * 4u)
+    {
+        a0 = ops::add(a0, ops::load(first));
+        a1 = ops::add(a1, ops::load(first + lanes));
+        a2 = ops::add(a2, ops::load(first + lanes * 2u));
+        a3 = ops::add(a3, ops::load(first + lanes * 3u));
+    }
+    T tmp[lanes];
+    ops::store(tmp, ops::add(ops::add(a0, a1), ops::add(a2, a3)));
+    auto sum = T();
+    for (auto const e : tmp)
+    {
+        sum += e;
+    }
+    return sum + sum_scalar(first, last);
+}
+
+template <typename T>
+BIZWEN_DEQUE_TARGET_AVX2 inline T dot_avx2(T const *a, T const *const last, T const *b) noexcept
+{
+    using ops = avx2_ops<T>;
+    constexpr auto lanes = ops::lanes;
+    auto a0 = ops::zero(), a1 = ops::zero(), a2 = ops::zero(), a3 = ops::zero();
+    for (; static_cast<::std::size_t>(last - a) >= lanes * 4u; a += lanes * 4u, b += lanes * 4u)
+    {
+        a0 = ops::add(a0, ops::mul(ops::load(a), ops::load(b)));
+        a1 = ops::add(a1, ops::mul(ops::load(a + lanes), ops::load(b + lanes)));
+        a2 = ops::add(a2, ops::mul(ops::load(a + lanes * 2u), ops::load(b + lanes * 2u)));
+        a3 = ops::add(a3, ops::mul(ops::load(a + lanes * 3u), ops::load(b + lanes * 3u)));
+    }
+    T tmp[lanes];
+    ops::store(tmp, ops::add(ops::add(a0, a1), ops::add(a2, a3)));
+    auto sum = T();
+    for (auto const e : tmp)
+    {
+        sum += e;
+    }
+    return sum + dot_scalar(a, last, b);
+}
+
+template <typename T>
+BIZWEN_DEQUE_TARGET_AVX2 inline void minmax_avx2(T const *first, T const *const last, T &min, T &max) noexcept
+{
+    using ops = avx2_ops<T>;
+    constexpr auto lanes = ops::lanes;
+    if (static_cast<::std::size_t>(last - first) >= lanes * 2u)
+    {
+        auto l0 = ops::set1(min), l1 = l0, h0 = ops::set1(max), h1 = h0;
+        for (; static_cast<::std::size_t>(last - first) >= lanes * 2u; first += lanes * 2u)
+        {
+            auto const v0 = ops::load(first);
+            auto const v1 = ops::load(first + lanes);
+            l0 = ops::min(l0, v0);
+            l1 = ops::min(l1, v1);
+            h0 = ops::max(h0, v0);
+            h1 = ops::max(h1, v1);
+        }
+        T lo[lanes];
+        T hi[lanes];
+        ops::store(lo, ops::min(l0, l1));
+        ops::store(hi, ops::max(h0, h1));
+        minmax_scalar(lo, lo + lanes, min, max);
+        minmax_scalar(hi, hi + lanes, min, max);
+    }
+    minmax_scalar(first, last, min, max);
+}
+
+inline bool detect_avx2() noexcept
+{
+#if defined(__AVX2__)
+    return true;
+#elif defined(_MSC_VER)
+    int info[4]{};
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+    __cpuid(info, 1);
+    // OSXSAVE和AVX
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+    {
+        return false;
+    }
+    // 操作系统保存了YMM寄存器
+    if ((_xgetbv(0) & 6u) != 6u)
+    {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+inline bool has_avx2() noexcept
+{
+    static bool const result = detect_avx2();
+    return result;
+}
+#endif
+
+// 返回第一个等于（Eq为false时不等于）value的位置，没有时返回last
+template <bool Eq, vectorizable T>
+inline T const *find(T const *const first, T const *const last, T const value) noexcept
+{
+#if defined(BIZWEN_DEQUE_SIMD_X86)
+    if (has_avx2())
+    {
+        return find_avx2<Eq>(first, last, value);
+    }
+    return find_sse2<Eq>(first, last, value);
+#else
+    return find_scalar<Eq>(first, last, value);
+#endif
+}
+
+template <vectorizable T>
+inline ::std::size_t count(T const *const first, T const *const last, T const value) noexcept
+{
+#if defined(BIZWEN_DEQUE_SIMD_X86)
+    if (has_avx2())
+    {
+        return count_avx2(first, last, value);
+    }
+    return count_sse2(first, last, value);
+#else
+    return count_scalar(first, last, value);
+#endif
+}
+// 同一段数据的结果取决于运行时选择的指令集，需要可复现的结果时使用pairwise_sum
+template <typename T>
+inline T sum(T const *const first, T const *const last) noexcept
+{
+#if defined(BIZWEN_DEQUE_SIMD_X86)
+    if constexpr (::std::floating_point<T>)
+    {
+        if (has_avx2())
+        {
+            return sum_avx2(first, last);
+        }
+        return sum_sse2(first, last);
+    }
+#endif
+    return sum_scalar(first, last);
+}
+
+template <typename T>
+inline T dot(T const *const a, T const *const last, T const *const b) noexcept
+{
+#if defined(BIZWEN_DEQUE_SIMD_X86)
+    if constexpr (::std::floating_point<T>)
+    {
+        if (has_avx2())
+        {
+            return dot_avx2(a, last, b);
+        }
+        return dot_sse2(a, last, b);
+    }
+#endif
+    return dot_scalar(a, last, b);
+}
+
+// 存在NaN时结果未指定
+template <typename T>
+inline void minmax(T const *const first, T const *const last, T &min, T &max) noexcept
+{
+#if defined(BIZWEN_DEQUE_SIMD_X86)
+    if constexpr (::std::floating_point<T>)
+    {
+        if (has_avx2())
+        {
+            return minmax_avx2(first, last, min, max);
+        }
+        return minmax_sse2(first, last, min, max);
+    }
+#endif
+    minmax_scalar(first, last, min, max);
+}
+} // namespace simd_detail
+} // namespace bizwen
+
+#endif
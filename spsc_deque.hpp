@@ -0,0 +1,268 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_SPSC_DEQUE_HPP)
+#define BIZWEN_SPSC_DEQUE_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// block_elements_v/cache_line_size_v
+#include "./deque.hpp"
+// assert
+#include <cassert>
+// size_t
+#include <cstddef>
+// atomic
+#include <atomic>
+// allocator_traits/construct_at/destroy_at
+#include <memory>
+// optional
+#include <optional>
+// is_same/is_nothrow_move_constructible
+#include <type_traits>
+// move/forward
+#include <utility>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+// 单生产者单消费者无锁队列
+// 生产者在elem_end一侧追加，消费者在elem_begin一侧弹出，双方通过计数发布进度
+// 块组成单向链表，因此容量没有上限且扩容不移动元素
+// 消费者用完的块通过回收槽交还给生产者，稳定状态下不分配内存
+BIZWEN_EXPORT template <typename T, typename Alloc = ::std::allocator<T>>
+class spsc_deque
+{
+    static_assert(::std::is_object_v<T> && !::std::is_const_v<T>);
+
+    struct block_
+    {
+        ::std::atomic<block_ *> next_{};
+        alignas(T) unsigned char storage_[sizeof(T) * deque_detail::block_elements_v<T>];
+
+        constexpr T *begin() noexcept
+        {
+            return reinterpret_cast<T *>(storage_);
+        }
+
+        constexpr T *end() noexcept
+        {
+            return begin() + deque_detail::block_elements_v<T>;
+        }
+    };
+
+    using block_atraits_t_ = typename ::std::allocator_traits<Alloc>::template rebind_traits<block_>;
+    using block_alloc_t_ = typename ::std::allocator_traits<Alloc>::template rebind_alloc<block_>;
+
+    // 块在两个线程之间传递，因此不支持fancy pointer
+    static_assert(::std::is_same_v<typename block_atraits_t_::pointer, block_ *>);
+
+#if __has_cpp_attribute(msvc::no_unique_address)
+    [[msvc::no_unique_address]] block_alloc_t_ allocator_{};
+#else
+    [[no_unique_address]] block_alloc_t_ allocator_{};
+#endif
+
+    // 生产者独占
+    alignas(deque_detail::cache_line_size_v) block_ *block_end_{};
+    T *elem_end_end_{};
+    T *elem_end_last_{};
+    ::std::size_t end_{};
+
+    // 消费者独占
+    alignas(deque_detail::cache_line_size_v) block_ *block_begin_{};
+    T *elem_begin_begin_{};
+    T *elem_begin_end_{};
+    ::std::size_t begin_{};
+    // 最近一次看到的生产者计数
+    ::std::size_t end_cache_{};
+
+    // 双方共享
+    alignas(deque_detail::cache_line_size_v)::std::atomic<::std::size_t> end_pub_{};
+    alignas(deque_detail::cache_line_size_v)::std::atomic<::std::size_t> begin_pub_{};
+    ::std::atomic<block_ *> recycle_{};
+
+    constexpr block_ *alloc_block_()
+    {
+        auto const block = block_atraits_t_::allocate(allocator_, ::std::size_t(1)); // may throw
+        ::std::construct_at(block);
+        return block;
+    }
+
+    constexpr void dealloc_block_(block_ *const block) noexcept
+    {
+        ::std::destroy_at(block);
+        block_atraits_t_::deallocate(allocator_, block, ::std::size_t(1));
+    }
+
+    // 生产者调用，优先使用回收槽中的块
+    constexpr void extent_block_()
+    {
+        auto block = recycle_.exchange(nullptr, ::std::memory_order_acquire);
+        if (block == nullptr)
+        {
+            block = alloc_block_(); // may throw
+        }
+        else
+        {
+            block->next_.store(nullptr, ::std::memory_order_relaxed);
+        }
+        block_end_->next_.store(block, ::std::memory_order_release);
+        block_end_ = block;
+        elem_end_end_ = block->begin();
+        elem_end_last_ = block->end();
+    }
+
+    // 消费者调用，槽已被占用时直接释放
+    constexpr void recycle_block_(block_ *const block) noexcept
+    {
+        auto const old = recycle_.exchange(block, ::std::memory_order_acq_rel);
+        if (old != nullptr)
+        {
+            dealloc_block_(old);
+        }
+    }
+
+  public:
+    using value_type = T;
+    using size_type = ::std::size_t;
+    using allocator_type = Alloc;
+
+    constexpr spsc_deque()
+        requires ::std::default_initializable<Alloc>
+        : spsc_deque(Alloc())
+    {
+    }
+
+    explicit constexpr spsc_deque(Alloc const &alloc) : allocator_(alloc)
+    {
+        auto const block = alloc_block_(); // may throw
+        block_end_ = block;
+        elem_end_end_ = block->begin();
+        elem_end_last_ = block->end();
+        block_begin_ = block;
+        elem_begin_begin_ = block->begin();
+        elem_begin_end_ = block->end();
+    }
+
+    spsc_deque(spsc_deque const &) = delete;
+
+    spsc_deque &operator=(spsc_deque const &) = delete;
+
+    // 析构时不能有其他线程访问
+    constexpr ~spsc_deque()
+    {
+        auto count = end_pub_.load(::std::memory_order_acquire) - begin_;
+        auto block = block_begin_;
+        auto elem = elem_begin_begin_;
+        for (;;)
+        {
+            if constexpr (!::std::is_trivially_destructible_v<T>)
+            {
+                for (; count != ::std::size_t(0) && elem != block->end(); ++elem, (void)--count)
+                {
+                    ::std::destroy_at(elem);
+                }
+            }
+            auto const next = block->next_.load(::std::memory_order_relaxed);
+            dealloc_block_(block);
+            if (next == nullptr)
+            {
+                break;
+            }
+            block = next;
+            elem = block->begin();
+        }
+        if (auto const recycled = recycle_.load(::std::memory_order_relaxed); recycled != nullptr)
+        {
+            dealloc_block_(recycled);
+        }
+    }
+
+    constexpr Alloc get_allocator() const noexcept
+    {
+        return Alloc(allocator_);
+    }
+
+    // 只由生产者调用
+    template <typename... V>
+    constexpr void emplace_back(V &&...v)
+    {
+        if (elem_end_end_ == elem_end_last_)
+        {
+            extent_block_(); // may throw
+        }
+        ::std::construct_at(elem_end_end_, ::std::forward<V>(v)...); // may throw
+        ++elem_end_end_;
+        ++end_;
+        end_pub_.store(end_, ::std::memory_order_release);
+    }
+
+    constexpr void push_back(T const &value)
+    {
+        emplace_back(value);
+    }
+
+    constexpr void push_back(T &&value)
+    {
+        emplace_back(::std::move(value));
+    }
+
+    // 只由消费者调用，为空时返回nullopt
+    constexpr ::std::optional<T> pop_front() noexcept(::std::is_nothrow_move_constructible_v<T>)
+    {
+        if (begin_ == end_cache_)
+        {
+            end_cache_ = end_pub_.load(::std::memory_order_acquire);
+            if (begin_ == end_cache_)
+            {
+                return ::std::nullopt;
+            }
+        }
+        if (elem_begin_begin_ == elem_begin_end_)
+        {
+            // 生产者已经链接了下一个块，当前块不会再被使用
+            auto const next = block_begin_->next_.load(::std::memory_order_acquire);
+            assert(next != nullptr);
+            recycle_block_(block_begin_);
+            block_begin_ = next;
+            elem_begin_begin_ = next->begin();
+            elem_begin_end_ = next->end();
+        }
+        auto const elem = elem_begin_begin_;
+        ::std::optional<T> result{::std::move(*elem)}; // may throw
+        ::std::destroy_at(elem);
+        ++elem_begin_begin_;
+        ++begin_;
+        begin_pub_.store(begin_, ::std::memory_order_release);
+        return result;
+    }
+
+    // 并发时只是近似值
+    constexpr size_type size() const noexcept
+    {
+        auto const begin = begin_pub_.load(::std::memory_order_acquire);
+        auto const end = end_pub_.load(::std::memory_order_acquire);
+        return end > begin ? end - begin : size_type(0);
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return size() == size_type(0);
+    }
+};
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
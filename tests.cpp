@@ -2,10 +2,28 @@
 // Distributed under the MIT License.
 // https://github.com/YexuanXiao/deque
 
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <coroutine>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
 #include <ranges>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 #include <version>
+#if defined(__cpp_lib_execution)
+#include <execution>
+#endif
 
 #if defined(TEST_CONSIS)
 #include <deque>
@@ -20,7 +38,29 @@ inline constexpr std::size_t operator"" uz(unsigned long long const value) noexc
 #endif
 
 #define BIZWEN_DEQUE_BASE_BLOCK_SIZE 256uz
+#include "./algorithm.hpp"
+#include "./async_channel.hpp"
+#include "./concurrent_queue.hpp"
 #include "./deque.hpp"
+#include "./dynamic_buffer.hpp"
+#include "./parallel.hpp"
+#include "./records.hpp"
+#include "./serialize.hpp"
+#include "./spsc_deque.hpp"
+#include "./ws_deque.hpp"
+#if __has_include(<sys/mman.h>)
+#include "./huge_page.hpp"
+#include "./mapped_deque.hpp"
+#include "./vm_deque.hpp"
+#include <filesystem>
+#endif
+#if defined(__linux__)
+#include "./magic_ring.hpp"
+#include "./shared_deque.hpp"
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 template <std::size_t Size>
 class vsn
@@ -416,6 +456,45 @@ void test_emplace_insert(std::size_t count = 1000uz)
     }
 }
 
+template <typename deque>
+void test_erase(std::size_t count = 1000uz)
+{
+    for (auto i = 0uz; i < count; i += 37uz)
+    {
+        for (auto n : {0uz, 1uz, i / 3uz, i / 2uz, i})
+        {
+            if (n > i)
+            {
+                continue;
+            }
+            {
+                deque d{std::from_range, std::ranges::iota_view(0uz, i)};
+                d.erase(d.begin(), d.begin() + n);
+                assert(d.size() == i - n);
+                for (auto j = 0uz; j != d.size(); ++j)
+                {
+                    assert(d[j] == j + n);
+                }
+                d.push_front(0uz);
+                d.push_back(0uz);
+                assert(d.size() == i - n + 2uz);
+            }
+            {
+                deque d{std::from_range, std::ranges::iota_view(0uz, i)};
+                d.erase(d.end() - n, d.end());
+                assert(d.size() == i - n);
+                for (auto j = 0uz; j != d.size(); ++j)
+                {
+                    assert(d[j] == j);
+                }
+                d.push_front(0uz);
+                d.push_back(0uz);
+                assert(d.size() == i - n + 2uz);
+            }
+        }
+    }
+}
+
 template <typename Type>
 void test_all(std::size_t count = 1000uz)
 {
@@ -434,6 +513,7 @@ void test_all(std::size_t count = 1000uz)
         test_prep_app_end_range<std::deque<Type>>(count);
         test_resize<std::deque<Type>>(count);
         test_emplace_insert<std::deque<Type>>(count);
+        test_erase<std::deque<Type>>(count);
     }
 #else
 #error "requires __cpp_lib_containers_ranges"
@@ -453,6 +533,7 @@ void test_all(std::size_t count = 1000uz)
         test_prep_app_end_range<bizwen::deque<Type>>(count);
         test_resize<bizwen::deque<Type>>(count);
         test_emplace_insert<bizwen::deque<Type>>(count);
+        test_erase<bizwen::deque<Type>>(count);
     }
 #endif
 #if !defined(TEST_CONSIS) && !defined(TEST_FUNC)
@@ -469,25 +550,1872 @@ void test_buckets(int n)
     {
         for (auto j : i)
         {
+            assert(j == x);
             j = x++;
         }
     }
+    assert(x == n);
+    // shrinking to a multiple of the block size must not leave an empty tail block
+    c.resize(static_cast<std::size_t>(n / 2));
+    auto total = 0uz;
+    for (auto i : c.buckets())
+    {
+        assert(!i.empty());
+        total += i.size();
+    }
+    assert(total == c.size());
 }
-#endif
 
-int main()
+// counts the allocations of the control array, whose elements are block pointers
+template <typename T>
+struct ctrl_counting_allocator
 {
-    test_all<vsn<1uz>>();
-    test_all<vsn<2uz>>();
-    test_all<vsn<3uz>>();
-    test_all<vsn<4uz>>();
-    test_all<vsn<5uz>>();
-    test_all<vsn<6uz>>();
-    test_all<vsn<7uz>>();
-    test_all<vsn<8uz>>();
-    test_all<vsn<9uz>>();
-#if defined(TEST_FUNC)
-    for (auto x = 0; x < 100000; ++x)
-        test_buckets(x);
+    using value_type = T;
+
+    std::size_t *ctrl_allocations;
+
+    explicit ctrl_counting_allocator(std::size_t *count) noexcept : ctrl_allocations(count)
+    {
+    }
+
+    template <typename U>
+    ctrl_counting_allocator(ctrl_counting_allocator<U> const &other) noexcept : ctrl_allocations(other.ctrl_allocations)
+    {
+    }
+
+    T *allocate(std::size_t n)
+    {
+        if constexpr (std::is_pointer_v<T>)
+        {
+            ++*ctrl_allocations;
+        }
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T *p, std::size_t n) noexcept
+    {
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <typename U>
+    friend bool operator==(ctrl_counting_allocator const &lhs, ctrl_counting_allocator<U> const &rhs) noexcept
+    {
+        return lhs.ctrl_allocations == rhs.ctrl_allocations;
+    }
+};
+
+void test_ctrl_growth()
+{
+    // 4096 blocks; growing the control array block by block reallocated it about a thousand times
+    constexpr auto count = 4096uz * (4096uz / sizeof(std::uint64_t));
+    for (auto front : {false, true})
+    {
+        auto allocations = 0uz;
+        bizwen::deque<std::uint64_t, ctrl_counting_allocator<std::uint64_t>> d(
+            ctrl_counting_allocator<std::uint64_t>{&allocations});
+        for (auto i = 0uz; i != count; ++i)
+        {
+            if (front)
+            {
+                d.push_front(i);
+            }
+            else
+            {
+                d.push_back(i);
+            }
+        }
+        assert(d.size() == count && allocations <= 16uz);
+        assert(front ? d.front() == count - 1uz && d.back() == 0uz : d.front() == 0uz && d.back() == count - 1uz);
+    }
+}
+
+void test_ws_deque(std::size_t thieves, std::size_t count)
+{
+    bizwen::ws_deque<std::size_t> q{};
+    std::atomic<bool> done{};
+    std::atomic<std::size_t> stolen_count{};
+    std::atomic<std::size_t> stolen_sum{};
+    std::vector<std::thread> threads{};
+    for (auto i = 0uz; i != thieves; ++i)
+    {
+        threads.emplace_back([&] {
+            while (!done.load())
+            {
+                if (auto const v = q.steal())
+                {
+                    stolen_count += 1uz;
+                    stolen_sum += *v;
+                }
+            }
+        });
+    }
+    auto own_count = 0uz;
+    auto own_sum = 0uz;
+    for (auto i = 0uz; i != count; ++i)
+    {
+        q.push_back(i);
+        // pop some elements so that the owner competes with thieves
+        if (i % 3uz == 0uz)
+        {
+            if (auto const v = q.pop_back())
+            {
+                ++own_count;
+                own_sum += *v;
+            }
+        }
+    }
+    while (!q.empty())
+    {
+        if (auto const v = q.pop_back())
+        {
+            ++own_count;
+            own_sum += *v;
+        }
+    }
+    done.store(true);
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+    assert(own_count + stolen_count == count);
+    assert(own_sum + stolen_sum == count * (count - 1uz) / 2uz);
+}
+
+void test_spsc_deque(std::size_t count)
+{
+    bizwen::spsc_deque<std::vector<std::size_t>> q{};
+    std::thread producer([&] {
+        for (auto i = 0uz; i != count; ++i)
+        {
+            q.emplace_back(1uz, i);
+        }
+    });
+    for (auto i = 0uz; i != count;)
+    {
+        if (auto const v = q.pop_front())
+        {
+            assert(v->size() == 1uz);
+            assert(v->front() == i);
+            ++i;
+        }
+    }
+    producer.join();
+    assert(q.empty());
+    assert(!q.pop_front());
+    // leave elements in the queue for the destructor
+    for (auto i = 0uz; i != count; ++i)
+    {
+        q.emplace_back(1uz, i);
+    }
+}
+
+void test_concurrent_queue(std::size_t threads, std::size_t capacity, std::size_t count)
+{
+    bizwen::concurrent_queue<std::size_t> q(capacity);
+    std::atomic<std::size_t> popped_count{};
+    std::atomic<std::size_t> popped_sum{};
+    std::vector<std::thread> producers{};
+    std::vector<std::thread> consumers{};
+    for (auto t = 0uz; t != threads; ++t)
+    {
+        consumers.emplace_back([&] {
+            std::vector<std::size_t> buffer(64uz);
+            while (auto const n = q.pop_n(buffer.begin(), buffer.size()))
+            {
+                popped_count += n;
+                for (auto i = 0uz; i != n; ++i)
+                {
+                    popped_sum += buffer[i];
+                }
+            }
+        });
+        producers.emplace_back([&] {
+            // half by batches and half by single elements
+            for (auto i = 0uz; i < count / 2uz; i += 100uz)
+            {
+                [[maybe_unused]] auto const n = q.push_range(std::views::iota(i, std::min(i + 100uz, count / 2uz)));
+                assert(n == std::min(100uz, count / 2uz - i));
+            }
+            for (auto i = count / 2uz; i != count; ++i)
+            {
+                [[maybe_unused]] auto const pushed = q.push(i);
+                assert(pushed);
+            }
+        });
+    }
+    for (auto &t : producers)
+    {
+        t.join();
+    }
+    q.close();
+    for (auto &t : consumers)
+    {
+        t.join();
+    }
+    assert(popped_count == threads * count);
+    assert(popped_sum == threads * (count * (count - 1uz) / 2uz));
+    [[maybe_unused]] auto const pushed = q.push(0uz);
+    [[maybe_unused]] auto const popped = q.pop();
+    assert(!pushed && !popped);
+    {
+        bizwen::concurrent_queue<std::size_t> q1(10uz);
+        [[maybe_unused]] auto const pushed_range = q1.try_push_range(std::views::iota(0uz, 15uz));
+        [[maybe_unused]] auto const pushed_full = q1.try_push(0uz);
+        assert(pushed_range == 10uz && !pushed_full);
+        std::vector<std::size_t> buffer(4uz);
+        [[maybe_unused]] auto const popped_n = q1.try_pop_n(buffer.begin(), 4uz);
+        assert(popped_n == 4uz && buffer[3] == 3uz);
+        // max == 0 returns at once even though nothing is closed
+        [[maybe_unused]] auto const popped_none = q1.pop_n(buffer.begin(), 0uz);
+        [[maybe_unused]] auto const popped_one = q1.try_pop();
+        assert(popped_none == 0uz && *popped_one == 4uz);
+        assert(q1.size() == 5uz);
+        bizwen::concurrent_queue<std::size_t> empty{};
+        [[maybe_unused]] auto const popped_empty = empty.pop_n(buffer.begin(), 0uz);
+        assert(popped_empty == 0uz);
+    }
+}
+
+// fire-and-forget coroutine, starts eagerly and destroys itself at the end
+struct detached_task
+{
+    struct promise_type
+    {
+        detached_task get_return_object() noexcept
+        {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void() noexcept
+        {
+        }
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+// starts eagerly like detached_task, but the frame is destroyed with the task, even while it is suspended
+struct scoped_task
+{
+    struct promise_type
+    {
+        scoped_task get_return_object() noexcept
+        {
+            return scoped_task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+        std::suspend_always final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void() noexcept
+        {
+        }
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+
+    explicit scoped_task(std::coroutine_handle<promise_type> h) noexcept : handle(h)
+    {
+    }
+    scoped_task(scoped_task &&other) noexcept : handle(std::exchange(other.handle, nullptr))
+    {
+    }
+    scoped_task &operator=(scoped_task &&) = delete;
+    ~scoped_task()
+    {
+        if (handle)
+        {
+            handle.destroy();
+        }
+    }
+};
+
+// single-threaded executor, resumption is deferred to run()
+struct queue_executor
+{
+    std::vector<std::coroutine_handle<>> *queue;
+
+    void operator()(std::coroutine_handle<> handle) const
+    {
+        queue->push_back(handle);
+    }
+
+    void run() const
+    {
+        for (auto i = 0uz; i != queue->size(); ++i)
+        {
+            (*queue)[i].resume();
+        }
+        queue->clear();
+    }
+};
+
+template <typename channel>
+detached_task channel_producer(channel &ch, std::size_t &running, std::size_t count)
+{
+    for (auto i = 0uz; i != count; ++i)
+    {
+        [[maybe_unused]] auto const pushed = co_await ch.push(i);
+        assert(pushed);
+    }
+    if (--running == 0uz)
+    {
+        ch.close();
+    }
+}
+
+template <typename channel>
+detached_task channel_consumer(channel &ch, std::size_t &popped_count, std::size_t &popped_sum)
+{
+    while (auto const value = co_await ch.pop())
+    {
+        ++popped_count;
+        popped_sum += *value;
+    }
+}
+
+template <typename channel>
+detached_task channel_batch_consumer(channel &ch, std::size_t &popped_count, std::size_t &popped_sum)
+{
+    for (;;)
+    {
+        auto const batch = co_await ch.pop_some(100uz);
+        if (batch.empty())
+        {
+            break;
+        }
+        assert(batch.size() <= 100uz);
+        popped_count += batch.size();
+        for (auto const i : batch)
+        {
+            popped_sum += i;
+        }
+    }
+}
+
+template <typename executor>
+void test_async_channel(executor ex, std::size_t producers, std::size_t capacity, std::size_t count)
+{
+    bizwen::async_channel<std::size_t, executor> ch(capacity, ex);
+    auto running = producers;
+    auto popped_count = 0uz;
+    auto popped_sum = 0uz;
+    channel_consumer(ch, popped_count, popped_sum);
+    channel_batch_consumer(ch, popped_count, popped_sum);
+    for (auto p = 0uz; p != producers; ++p)
+    {
+        channel_producer(ch, running, count);
+    }
+    if constexpr (requires { ex.run(); })
+    {
+        ex.run();
+    }
+    assert(ch.is_closed() && ch.empty());
+    assert(popped_count == producers * count);
+    assert(popped_sum == producers * (count * (count - 1uz) / 2uz));
+    [[maybe_unused]] auto const pushed_closed = ch.try_push(0uz);
+    assert(!pushed_closed);
+    [[maybe_unused]] auto const popped_closed = ch.try_pop();
+    assert(!popped_closed);
+}
+
+template <typename channel>
+detached_task channel_ping(channel &ping, channel &pong, std::size_t count, std::size_t &done)
+{
+    for (auto i = 0uz; i != count; ++i)
+    {
+        [[maybe_unused]] auto const pushed = co_await ping.push(i);
+        assert(pushed);
+        [[maybe_unused]] auto const value = co_await pong.pop();
+        assert(value && *value == i);
+    }
+    ++done;
+}
+
+template <typename channel>
+detached_task channel_pong(channel &ping, channel &pong, std::size_t count, std::size_t &done)
+{
+    for (auto i = 0uz; i != count; ++i)
+    {
+        auto const value = co_await ping.pop();
+        assert(value && *value == i);
+        [[maybe_unused]] auto const pushed = co_await pong.push(*value);
+        assert(pushed);
+    }
+    ++done;
+}
+
+template <typename channel>
+scoped_task channel_scoped_pop(channel &ch, std::size_t &popped)
+{
+    auto const value = co_await ch.pop();
+    popped = value ? *value : 0uz;
+}
+
+template <typename channel>
+scoped_task channel_scoped_push(channel &ch, std::size_t value)
+{
+    [[maybe_unused]] auto const pushed = co_await ch.push(value);
+}
+
+template <typename channel>
+scoped_task channel_scoped_pop_some(channel &ch, std::size_t &popped)
+{
+    auto const batch = co_await ch.pop_some(10uz);
+    popped = batch.size();
+}
+
+template <typename channel>
+detached_task channel_pop_then_reset(channel &ch, std::optional<scoped_task> &victim)
+{
+    [[maybe_unused]] auto const value = co_await ch.pop();
+    victim.reset();
+}
+
+template <typename channel>
+detached_task channel_destroy_after_pop(std::unique_ptr<channel> &ch, std::size_t &popped)
+{
+    auto const value = co_await ch->pop();
+    popped = *value;
+    ch.reset();
+}
+
+void test_async_channel(std::size_t producers, std::size_t capacity, std::size_t count)
+{
+    test_async_channel(bizwen::inline_executor{}, producers, capacity, count);
+    std::vector<std::coroutine_handle<>> queue{};
+    test_async_channel(queue_executor{&queue}, producers, capacity, count);
+    {
+        bizwen::async_channel<std::size_t> ch(3uz);
+        [[maybe_unused]] auto const pushed_1 = ch.try_push(1uz);
+        [[maybe_unused]] auto const pushed_2 = ch.try_push(2uz);
+        [[maybe_unused]] auto const pushed_3 = ch.try_push(3uz);
+        assert(pushed_1 && pushed_2 && pushed_3);
+        [[maybe_unused]] auto const pushed_full = ch.try_push(4uz);
+        assert(!pushed_full);
+        [[maybe_unused]] auto const popped = ch.try_pop();
+        assert(*popped == 1uz);
+        assert(ch.size() == 2uz);
+    }
+    {
+        // every handoff wakes the peer; with inline_executor the stack must not grow with count
+        bizwen::async_channel<std::size_t> ping(0uz);
+        bizwen::async_channel<std::size_t> pong(0uz);
+        auto done = 0uz;
+        channel_pong(ping, pong, 200000uz, done);
+        channel_ping(ping, pong, 200000uz, done);
+        assert(done == 2uz);
+    }
+    {
+        // the resumed consumer destroys the channel before try_push returns
+        auto ch = std::make_unique<bizwen::async_channel<std::size_t>>(0uz);
+        auto popped = 0uz;
+        channel_destroy_after_pop(ch, popped);
+        [[maybe_unused]] auto const pushed = ch->try_push(7uz);
+        assert(pushed && ch == nullptr && popped == 7uz);
+    }
+    {
+        // destroyed coroutines leave the wait lists
+        bizwen::async_channel<std::size_t> ch(0uz);
+        auto popped = 0uz;
+        {
+            auto const cancelled = channel_scoped_pop(ch, popped);
+        }
+        [[maybe_unused]] auto const pushed_nobody = ch.try_push(1uz);
+        assert(!pushed_nobody);
+        {
+            auto const cancelled = channel_scoped_push(ch, 2uz);
+        }
+        [[maybe_unused]] auto const popped_nobody = ch.try_pop();
+        assert(!popped_nobody);
+        auto const waiting = channel_scoped_pop(ch, popped);
+        [[maybe_unused]] auto const pushed = ch.try_push(3uz);
+        assert(pushed && popped == 3uz);
+    }
+    {
+        // a coroutine that has been woken but not resumed yet is destroyed by the one resumed before it
+        bizwen::async_channel<std::size_t> ch(1uz);
+        std::optional<scoped_task> victim{};
+        channel_pop_then_reset(ch, victim);
+        auto popped = 9uz;
+        victim.emplace(channel_scoped_pop(ch, popped));
+        ch.close();
+        assert(!victim && popped == 9uz);
+    }
+    {
+        // a pop_some lease whose batch was never created is given back
+        std::vector<std::coroutine_handle<>> queue{};
+        bizwen::async_channel<std::size_t, queue_executor> ch(4uz, queue_executor{&queue});
+        auto popped = 0uz;
+        std::optional<scoped_task> leasing{};
+        leasing.emplace(channel_scoped_pop_some(ch, popped));
+        [[maybe_unused]] auto const pushed = ch.try_push(4uz);
+        assert(pushed && queue.size() == 1uz);
+        leasing.reset();
+        queue.clear();
+        [[maybe_unused]] auto const value = ch.try_pop();
+        assert(value && *value == 4uz);
+    }
+}
+void test_parallel(bizwen::parallel::thread_pool &pool, std::size_t front, std::size_t back)
+{
+    bizwen::deque<std::size_t> d{};
+    // the first element is not at the beginning of its block
+    for (auto i = 0uz; i != front; ++i)
+    {
+        d.push_front(front - 1uz - i);
+    }
+    for (auto i = front; i != front + back; ++i)
+    {
+        d.push_back(i);
+    }
+    auto const size = front + back;
+    bizwen::parallel::for_each(pool, d, [](std::size_t &x) { x *= 2uz; });
+    for (auto i = 0uz; i != size; ++i)
+    {
+        assert(d[i] == i * 2uz);
+    }
+    bizwen::deque<unsigned char> bytes(size + 3uz);
+    bizwen::parallel::transform(pool, d, bytes, [](std::size_t x) { return static_cast<unsigned char>(x / 2uz); });
+    for (auto i = 0uz; i != size; ++i)
+    {
+        assert(bytes[i] == static_cast<unsigned char>(i));
+    }
+    bizwen::parallel::transform(pool, d, [](std::size_t x) { return x / 2uz; });
+    assert(bizwen::parallel::reduce(pool, d, 0uz) == size * (size - (size != 0uz)) / 2uz);
+    auto sum = 0uz;
+    for (auto const b : bytes)
+    {
+        sum += b;
+    }
+    assert(bizwen::parallel::reduce(pool, bytes, 0uz, [](std::size_t a, std::size_t b) { return a + b; }) == sum);
+}
+template <typename T>
+void test_parallel_copy(std::size_t front, std::size_t back)
+{
+    bizwen::deque<T> d{};
+    // std::string is not nothrow copy constructible and takes the serial path
+    auto const make = [](std::size_t i) {
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            return std::to_string(i);
+        }
+        else
+        {
+            return static_cast<T>(i);
+        }
+    };
+    for (auto i = 0uz; i != front; ++i)
+    {
+        d.emplace_front(make(i));
+    }
+    for (auto i = 0uz; i != back; ++i)
+    {
+        d.emplace_back(make(i));
+    }
+#if defined(__cpp_lib_execution)
+    bizwen::deque<T> seq(std::execution::seq, d);
+    assert(seq == d);
+    bizwen::deque<T> unseq(std::execution::unseq, d);
+    assert(unseq == d);
+    unseq.push_front(T{});
+    unseq.push_back(T{});
+    assert(unseq.size() == d.size() + 2uz);
+    // copies the blocks on other threads
+    bizwen::deque<T> par(std::execution::par, d);
+    assert(par == d);
+    par.push_front(T{});
+    par.push_back(T{});
+    assert(par.size() == d.size() + 2uz);
+    assert(bizwen::deque<T>(std::execution::par_unseq, d) == d);
+#endif
+}
+void test_sort(bizwen::parallel::thread_pool &pool, std::size_t front, std::size_t back)
+{
+    bizwen::deque<std::size_t> d{};
+    std::vector<std::size_t> v{};
+    // a simple LCG keeps the test deterministic, with duplicates
+    auto x = front * 31uz + back;
+    for (auto i = 0uz; i != front + back; ++i)
+    {
+        x = x * 6364136223846793005uz + 1442695040888963407uz;
+        v.push_back((x >> 33uz) % 1000uz);
+    }
+    for (auto i = 0uz; i != front; ++i)
+    {
+        d.push_front(v[front - 1uz - i]);
+    }
+    for (auto i = front; i != front + back; ++i)
+    {
+        d.push_back(v[i]);
+    }
+    auto d1 = d;
+    auto d2 = d;
+    std::ranges::sort(v);
+    bizwen::sort(d);
+    assert(std::ranges::equal(d, v));
+    bizwen::parallel::sort(pool, d1);
+    assert(std::ranges::equal(d1, v));
+    bizwen::parallel::sort(pool, d2, std::greater<>{});
+    assert(std::ranges::equal(d2, v | std::views::reverse));
+    // moved-from strings must still be assignable in the scratch buffers
+    bizwen::deque<std::string> s{};
+    for (auto i = 0uz; i != front; ++i)
+    {
+        s.push_front(std::to_string(v[i]));
+    }
+    for (auto i = front; i != front + back; ++i)
+    {
+        s.push_back(std::to_string(v[i]));
+    }
+    std::vector<std::string> sv(s.begin(), s.end());
+    std::ranges::sort(sv);
+    bizwen::parallel::sort(pool, s);
+    assert(std::ranges::equal(s, sv));
+}
+void test_binary_search(std::size_t front, std::size_t back)
+{
+    // every value appears three times
+    bizwen::deque<std::size_t> d{};
+    for (auto i = front; i != 0uz; --i)
+    {
+        d.push_front((i - 1uz) / 3uz);
+    }
+    for (auto i = front; i != front + back; ++i)
+    {
+        d.push_back(i / 3uz);
+    }
+    auto const &cd = d;
+    for (auto v = 0uz; v != (front + back) / 3uz + 2uz; ++v)
+    {
+        assert(bizwen::lower_bound(d, v) == std::lower_bound(d.begin(), d.end(), v));
+        assert(bizwen::upper_bound(cd, v) == std::upper_bound(cd.begin(), cd.end(), v));
+        auto const [first, last] = bizwen::equal_range(d, v);
+        auto const [first1, last1] = std::equal_range(d.begin(), d.end(), v);
+        assert(first == first1 && last == last1);
+    }
+    std::ranges::reverse(d);
+    assert(bizwen::lower_bound(d, 1uz, std::greater<>{}) == std::lower_bound(d.begin(), d.end(), 1uz, std::greater<>{}));
+}
+template <typename T>
+void test_find(std::size_t front, std::size_t back)
+{
+    bizwen::deque<T> d{};
+    std::vector<T> v{};
+    for (auto i = 0uz; i != front + back; ++i)
+    {
+        v.push_back(static_cast<T>(i % 97uz));
+    }
+    for (auto i = 0uz; i != front; ++i)
+    {
+        d.push_front(v[front - 1uz - i]);
+    }
+    for (auto i = front; i != front + back; ++i)
+    {
+        d.push_back(v[i]);
+    }
+    auto const &cd = d;
+    for (auto x : {0uz, 1uz, 50uz, 96uz, 97uz})
+    {
+        auto const value = static_cast<T>(x);
+        auto const pos = std::ranges::find(v, value) - v.begin();
+        assert(bizwen::find(d, value) - d.begin() == pos);
+        assert(bizwen::find(cd, value) - cd.begin() == pos);
+        assert(bizwen::contains(d, value) == (pos != std::ssize(v)));
+        assert(bizwen::count(d, value) == std::ranges::count(v, value));
+    }
+    auto const not_zero = std::ranges::find_if_not(v, [](T x) { return x == T{}; }) - v.begin();
+    assert(bizwen::find_not(d, T{}) - d.begin() == not_zero);
+    assert(bizwen::find_if_not(d, [](T x) { return x == T{}; }) - d.begin() == not_zero);
+    std::ranges::fill(d, T{});
+    assert(bizwen::find_not(d, T{}) == d.end());
+    if (!d.empty())
+    {
+        d.back() = T{1};
+        assert(bizwen::find_not(d, T{}) == d.end() - 1);
+    }
+}
+
+void test_search(std::size_t front, std::size_t back)
+{
+    // the same pattern repeats with growing gaps, so matches cross block boundaries
+    std::string s{};
+    for (auto i = 0uz; s.size() < front + back; ++i)
+    {
+        s.append(i % 7uz, 'a');
+        s.append("abcab");
+    }
+    s.resize(front + back);
+    bizwen::deque<char> d{};
+    for (auto i = 0uz; i != front; ++i)
+    {
+        d.push_front(s[front - 1uz - i]);
+    }
+    d.append_range(std::string_view{s}.substr(front));
+    for (std::string_view p : {"", "a", "abcab", "aaaaaaabcab", "aab", "abcabaaaaaaab", "x"})
+    {
+        for (auto pos = 0uz; pos < s.size(); pos += 97uz)
+        {
+            auto const sub = std::string_view{s}.substr(pos);
+            auto const sd = bizwen::deque<char>(sub.begin(), sub.end());
+            auto const expect = sub.find(p);
+            auto const result = bizwen::search(sd, p) - sd.begin();
+            assert(expect == std::string_view::npos ? result == std::ssize(sd) : result == std::ptrdiff_t(expect));
+        }
+        auto const expect = s.find(p);
+        assert(bizwen::search(d, p) - d.begin() ==
+               (expect == std::string::npos ? std::ssize(d) : std::ptrdiff_t(expect)));
+    }
+}
+
+template <typename T>
+void test_reduce(std::size_t front, std::size_t back)
+{
+    bizwen::deque<T> d{};
+    std::vector<T> v{};
+    for (auto i = 0uz; i != front + back; ++i)
+    {
+        v.push_back(static_cast<T>(static_cast<int>(i * 37uz % 97uz) - 48));
+    }
+    for (auto i = 0uz; i != front; ++i)
+    {
+        d.push_front(v[front - 1uz - i]);
+    }
+    for (auto i = front; i != front + back; ++i)
+    {
+        d.push_back(v[i]);
+    }
+    // same elements, different block layout
+    auto const d2 = bizwen::deque<T>(v.begin(), v.end());
+    // the values are small integers, so every order of summation is exact
+    auto sum = T{};
+    auto product = T{};
+    for (auto x : v)
+    {
+        sum += x;
+        product += x * x;
+    }
+    assert(bizwen::reduce(d) == sum);
+    assert(bizwen::reduce(d, T{1}) == sum + T{1});
+    assert(bizwen::reduce(d, 0ll, [](long long a, T b) { return a + static_cast<long long>(b); }) ==
+           static_cast<long long>(sum));
+    assert(bizwen::pairwise_sum(d) == sum);
+    assert(bizwen::dot(d, d2) == product);
+    assert(bizwen::pairwise_dot(d, d2) == product);
+    if (!v.empty())
+    {
+        auto const [min, max] = bizwen::minmax(d);
+        auto const [min1, max1] = std::ranges::minmax(v);
+        assert(min == min1 && max == max1);
+        auto const [min2, max2] = bizwen::minmax(d, std::greater<>{});
+        assert(min2 == max1 && max2 == min1);
+    }
+    if constexpr (std::floating_point<T>)
+    {
+        // rounding happens, but pairwise_sum only depends on the values and their order
+        std::ranges::transform(v, d.begin(), [](T x) { return T{1} / (x + T{0.5}); });
+        auto const d3 = bizwen::deque<T>(d.begin(), d.end());
+        auto const bits = [](T x) { return std::bit_cast<std::array<unsigned char, sizeof(T)>>(x); };
+        assert(bits(bizwen::pairwise_sum(d)) == bits(bizwen::pairwise_sum(d3)));
+        assert(bits(bizwen::pairwise_dot(d, d2)) == bits(bizwen::pairwise_dot(d3, d2)));
+    }
+}
+
+template <typename T>
+void test_compare(std::size_t front, std::size_t back)
+{
+    std::vector<T> v{};
+    for (auto i = 0uz; i != front + back; ++i)
+    {
+        v.push_back(static_cast<T>(i * 7uz % 200uz));
+    }
+    bizwen::deque<T> d{};
+    for (auto i = 0uz; i != front; ++i)
+    {
+        d.push_front(v[front - 1uz - i]);
+    }
+    d.append_range(std::ranges::subrange(v.begin() + std::ptrdiff_t(front), v.end()));
+    // same elements, different block layout
+    auto d2 = bizwen::deque<T>(v.begin(), v.end());
+    assert(d == d2 && (d <=> d2) == 0);
+    auto v2 = v;
+    for (auto pos = 0uz; pos < v.size(); pos += 211uz)
+    {
+        // a single element differs, both above and below
+        for (auto delta : {1, -1})
+        {
+            v2[pos] = static_cast<T>(v[pos] + delta);
+            d2[pos] = v2[pos];
+            assert(d != d2 && d2 != d);
+            assert((d <=> d2) == (v <=> v2));
+            assert((d2 <=> d) == (v2 <=> v));
+        }
+        v2[pos] = v[pos];
+        d2[pos] = v[pos];
+    }
+    // one is a prefix of the other
+    d2.push_back(T{});
+    assert(d != d2 && (d <=> d2) < 0 && (d2 <=> d) > 0);
+    d2.pop_back();
+    if (!d2.empty())
+    {
+        d2.pop_front();
+        d2.push_front(v.front());
+        assert(d == d2);
+    }
+}
+
+void test_hash(std::size_t front, std::size_t back)
+{
+    std::string s{};
+    for (auto i = 0uz; i != front + back; ++i)
+    {
+        s.push_back(static_cast<char>('a' + i * 7uz % 26uz));
+    }
+    bizwen::deque<char> d{};
+    for (auto i = 0uz; i != front; ++i)
+    {
+        d.push_front(s[front - 1uz - i]);
+    }
+    d.append_range(std::string_view{s}.substr(front));
+    auto const d2 = bizwen::deque<char>(s.begin(), s.end());
+    std::hash<bizwen::deque<char>> const h{};
+    // independent of the block layout and equal to hashing the contiguous buffer
+    assert(h(d) == h(d2));
+    assert(h(d) == h(std::span<char const>(s)));
+    std::unordered_set<bizwen::deque<char>> set{};
+    for (auto n = 0uz; n <= s.size(); n += 97uz)
+    {
+        set.emplace(s.begin(), s.begin() + std::ptrdiff_t(n));
+    }
+    assert(set.contains(d2) == (s.size() % 97uz == 0uz));
+    for (auto n = 0uz; n <= s.size(); n += 97uz)
+    {
+        auto key = d;
+        key.resize(n);
+        assert(set.contains(key));
+        if (n != 0uz)
+        {
+            // changing a single byte changes the hash
+            auto const old = h(key);
+            key[n / 2uz] = 'A';
+            assert(h(key) != old);
+        }
+    }
+    // types without unique object representations hash element by element
+    std::vector<std::string> v{};
+    bizwen::deque<std::string> ds{};
+    for (auto i = 0uz; i != (front + back) / 64uz; ++i)
+    {
+        v.push_back(s.substr(i, i % 5uz));
+        ds.push_front(v.back());
+    }
+    std::ranges::reverse(v);
+    auto const ds2 = bizwen::deque<std::string>(v.begin(), v.end());
+    std::hash<bizwen::deque<std::string>> const hs{};
+    assert(hs(ds) == hs(ds2) && hs(ds) == hs(std::span<std::string const>(v)));
+}
+
+void test_erase(std::size_t front, std::size_t back)
+{
+    std::vector<std::string> v{};
+    bizwen::deque<std::string> d{};
+    for (auto i = 0uz; i != front + back; ++i)
+    {
+        v.push_back(std::to_string(i * i % 7uz));
+    }
+    for (auto i = 0uz; i != front; ++i)
+    {
+        d.push_front(v[front - 1uz - i]);
+    }
+    d.append_range(std::ranges::subrange(v.begin() + std::ptrdiff_t(front), v.end()));
+    auto d2 = d;
+    auto v2 = v;
+    v2.erase(std::unique(v2.begin(), v2.end()), v2.end());
+    assert(bizwen::unique(d2) == v.size() - v2.size());
+    assert(std::ranges::equal(d2, v2));
+    assert(bizwen::erase(d, "1") == std::erase(v, "1"));
+    assert(std::ranges::equal(d, v));
+    assert(bizwen::erase_if(d, [](std::string const &e) { return e == "2" || e == "4"; }) ==
+           std::erase_if(v, [](std::string const &e) { return e == "2" || e == "4"; }));
+    assert(std::ranges::equal(d, v));
+    assert(bizwen::erase(d, "3") == 0uz && std::ranges::equal(d, v));
+    // the removed blocks stay usable
+    d.append_range(v);
+    d.insert(d.begin(), v.begin(), v.end());
+    assert(d.size() == v.size() * 3uz);
+    assert(bizwen::erase_if(d, [](auto const &) { return true; }) == v.size() * 3uz && d.empty());
+}
+
+void test_erase_indices(std::size_t front, std::size_t back)
+{
+    bizwen::deque<std::size_t> d{};
+    for (auto i = 0uz; i != front; ++i)
+    {
+        d.push_front(front - 1uz - i);
+    }
+    for (auto i = front; i != front + back; ++i)
+    {
+        d.push_back(i);
+    }
+    auto d2 = d;
+    std::vector<std::size_t> positions{};
+    std::vector<bool> marks(d.size());
+    for (auto i = 0uz; i < d.size(); i += i % 3uz + i % 511uz + 1uz)
+    {
+        positions.push_back(i);
+        // duplicates are allowed
+        if (i % 2uz == 0uz)
+        {
+            positions.push_back(i);
+        }
+        marks[i] = true;
+    }
+    std::vector<std::size_t> expect{};
+    for (auto i = 0uz; i != d.size(); ++i)
+    {
+        if (!marks[i])
+        {
+            expect.push_back(i);
+        }
+    }
+    auto const removed = d.size() - expect.size();
+    assert(bizwen::erase_indices(d, positions) == removed);
+    assert(std::ranges::equal(d, expect));
+    assert(bizwen::erase_marked(d2, marks) == removed);
+    assert(std::ranges::equal(d2, expect));
+    assert(bizwen::erase_indices(d, std::vector<std::size_t>{}) == 0uz && std::ranges::equal(d, expect));
+}
+
+void test_insert_many(std::size_t front, std::size_t back)
+{
+    bizwen::deque<std::string> d{};
+    std::vector<std::string> v{};
+    for (auto i = 0uz; i != front; ++i)
+    {
+        d.push_front(std::to_string(front - 1uz - i));
+    }
+    for (auto i = front; i != front + back; ++i)
+    {
+        d.push_back(std::to_string(i));
+    }
+    v.assign(d.begin(), d.end());
+    for (auto step : {1uz, 7uz, 300uz, 5000uz})
+    {
+        std::vector<std::pair<std::size_t, std::string>> items{};
+        for (auto pos = 0uz; pos <= v.size(); pos += step)
+        {
+            items.emplace_back(pos, "x" + std::to_string(pos));
+            // several values at the same position keep their order
+            if (pos % 3uz == 0uz)
+            {
+                items.emplace_back(pos, "y" + std::to_string(pos));
+            }
+        }
+        items.emplace_back(v.size(), "end");
+        for (auto const &[pos, value] : items | std::views::reverse)
+        {
+            // items at the same position are inserted in reverse, each before the previous one
+            v.insert(v.begin() + std::ptrdiff_t(pos), value);
+        }
+        d.insert_many(items);
+        assert(std::ranges::equal(d, v));
+    }
+    // moves the values out when the range yields rvalues
+    std::vector<std::pair<std::size_t, std::string>> items{{0uz, std::string(100uz, 'a')}};
+    d.insert_many(items | std::views::transform([](auto &item) {
+                      return std::pair<std::size_t, std::string &&>(item.first, std::move(item.second));
+                  }));
+    assert(d.front() == std::string(100uz, 'a') && items.front().second.empty());
+    d.insert_many(std::vector<std::pair<std::size_t, std::string>>{});
+    bizwen::deque<std::string> e{};
+    e.insert_many(std::vector<std::pair<std::size_t, std::string>>{{0uz, "a"}, {0uz, "b"}});
+    assert(e.size() == 2uz && e.front() == "a" && e.back() == "b");
+}
+
+void test_sliding_window(std::size_t window)
+{
+    struct counting_resource : std::pmr::memory_resource
+    {
+        std::size_t count{};
+
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            ++count;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(std::pmr::memory_resource const &other) const noexcept override
+        {
+            return this == &other;
+        }
+    } resource{};
+    bizwen::pmr::deque<std::size_t> d(&resource);
+    auto const total = window * 20uz + 100000uz;
+    auto allocations = 0uz;
+    for (auto i = 0uz; i != total; ++i)
+    {
+        if (i == window * 4uz + 10000uz)
+        {
+            allocations = resource.count;
+        }
+        d.push_back_evict(window, i);
+        assert(d.size() == (std::min)(i + 1uz, window) && d.back() == i);
+    }
+    // the window runs without allocating once it is warm
+    assert(resource.count == allocations);
+    assert(std::ranges::equal(d, std::views::iota(total - window, total)));
+    // the argument may refer to the element being evicted
+    bizwen::deque<std::string> s{};
+    for (auto i = 0uz; i != 100uz; ++i)
+    {
+        s.push_back_evict(window, std::to_string(i));
+    }
+    s.emplace_back_evict(window, s.front());
+    assert(s.back() == std::to_string(100uz - (std::min)(window, 100uz)));
+}
+
+void test_fifo(std::size_t window)
+{
+    // blocks freed at one end are moved to the other end of the control array
+    bizwen::deque<std::size_t> d{};
+    std::deque<std::size_t> r{};
+    for (auto i = 0uz; i != window * 8uz + 20000uz; ++i)
+    {
+        d.push_back(i);
+        r.push_back(i);
+        if (d.size() > window)
+        {
+            d.pop_front();
+            r.pop_front();
+        }
+    }
+    assert(std::ranges::equal(d, r));
+    for (auto i = 0uz; i != window * 8uz + 20000uz; ++i)
+    {
+        d.push_front(i);
+        r.push_front(i);
+        if (d.size() > window * 2uz)
+        {
+            d.pop_back();
+            r.pop_back();
+        }
+    }
+    assert(std::ranges::equal(d, r));
+}
+
+#if __has_include(<sys/mman.h>)
+void test_vm_deque()
+{
+    // a small reservation so that both ends reach its boundaries
+    bizwen::vm_deque<std::size_t> d(bizwen::vm_deque<std::size_t>::reservation{1uz << 20});
+    std::deque<std::size_t> r{};
+    for (auto i = 0uz; i != 50000uz; ++i)
+    {
+        if (i % 3uz == 0uz)
+        {
+            d.push_front(i);
+            r.push_front(i);
+        }
+        else
+        {
+            d.push_back(i);
+            r.push_back(i);
+        }
+    }
+    assert(std::ranges::equal(d, r));
+    auto b = d.buckets();
+    assert(std::ranges::distance(b) == 1 && (*b.begin()).data() == d.data() && (*b.begin()).size() == d.size());
+    for (auto i = 0uz; i != 40000uz; ++i)
+    {
+        d.pop_front();
+        r.pop_front();
+    }
+    // a FIFO drifts towards the end of the reservation and is moved back to the middle
+    for (auto i = 0uz; i != 300000uz; ++i)
+    {
+        d.push_back(i);
+        d.pop_front();
+        r.push_back(i);
+        r.pop_front();
+    }
+    assert(std::ranges::equal(d, r));
+    d.shrink_to_fit();
+    assert(std::ranges::equal(d, r));
+    d.insert(d.begin() + 5, 7uz);
+    r.insert(r.begin() + 5, 7uz);
+    d.erase(d.end() - 9, d.end() - 2);
+    r.erase(r.end() - 9, r.end() - 2);
+    d.erase(d.begin() + 1, d.begin() + 4);
+    r.erase(r.begin() + 1, r.begin() + 4);
+    assert(std::ranges::equal(d, r) && d.at(3uz) == r.at(3uz));
+    auto c = d;
+    assert(c == d && !(c < d));
+    c.push_back(0uz);
+    assert(c != d && d < c);
+    d = std::move(c);
+    assert(d.size() == r.size() + 1uz);
+    // elements may occupy at most half of the reservation
+    auto thrown = false;
+    try
+    {
+        d.resize(1uz << 20);
+    }
+    catch (std::length_error const &)
+    {
+        thrown = true;
+    }
+    assert(thrown && d.size() == r.size() + 1uz);
+    bizwen::vm_deque<std::string> s(1000uz, std::string(40uz, 'x'));
+    s.resize(10uz);
+    s.shrink_to_fit();
+    s.emplace_front(std::string(50uz, 'y'));
+    assert(s.size() == 11uz && s.front().size() == 50uz && s.back() == std::string(40uz, 'x'));
+    // the argument refers to an element that is moved when the deque is moved back to the middle
+    bizwen::vm_deque<std::string> a(bizwen::vm_deque<std::string>::reservation{1uz << 16});
+    std::deque<std::string> ra{};
+    for (auto i = 0uz; i != 3000uz; ++i)
+    {
+        auto value = std::to_string(i) + std::string(20uz, 'a');
+        a.push_back(value);
+        ra.push_back(value);
+        a.push_back(a.front());
+        ra.push_back(ra.front());
+        assert(a.back() == ra.back());
+        a.pop_front();
+        ra.pop_front();
+        a.emplace_front(a.back());
+        ra.emplace_front(ra.back());
+        assert(a.front() == ra.front());
+        a.insert(a.end() - 1, 2uz, a.front());
+        ra.insert(ra.end() - 1, 2uz, ra.front());
+        assert(a[a.size() - 2uz] == ra[ra.size() - 2uz]);
+        a.append_range(std::ranges::subrange(a.begin(), a.begin() + 2));
+        ra.insert(ra.end(), {ra[0uz], ra[1uz]});
+        a.prepend_range(std::ranges::subrange(a.end() - 2, a.end()));
+        ra.insert(ra.begin(), {ra[ra.size() - 2uz], ra.back()});
+        assert(std::ranges::equal(a, ra));
+        if (a.size() > 500uz)
+        {
+            // trim mostly the back in the second half, so that both ends reach the boundaries
+            if (i % 400uz < (i < 1500uz ? 200uz : 50uz))
+            {
+                a.erase(a.begin(), a.begin() + 300);
+                ra.erase(ra.begin(), ra.begin() + 300);
+            }
+            else
+            {
+                a.erase(a.end() - 300, a.end());
+                ra.erase(ra.end() - 300, ra.end());
+            }
+        }
+    }
+    assert(std::ranges::equal(a, ra));
+    // ranges that refer to the deque itself while both ends reach the boundaries
+    bizwen::vm_deque<std::size_t> g(bizwen::vm_deque<std::size_t>::reservation{1uz << 16});
+    std::deque<std::size_t> rg{};
+    g.assign({1uz, 2uz, 3uz});
+    rg.assign({1uz, 2uz, 3uz});
+    for (auto i = 0uz; i != 3000uz; ++i)
+    {
+        auto const head = std::vector<std::size_t>(rg.begin(), rg.begin() + 3);
+        g.append_range(std::ranges::subrange(g.begin(), g.begin() + 3));
+        rg.insert(rg.end(), head.begin(), head.end());
+        g.prepend_range(std::ranges::subrange(g.end() - 2, g.end()));
+        rg.insert(rg.begin(), rg.end() - 2, rg.end());
+        g.pop_back();
+        rg.pop_back();
+        assert(std::ranges::equal(g, rg));
+        if (g.size() > 1000uz)
+        {
+            g.erase(g.end() - 600, g.end());
+            rg.erase(rg.end() - 600, rg.end());
+        }
+    }
+    assert(std::ranges::equal(g, rg));
+    g.append_range(g);
+    rg.insert(rg.end(), rg.begin(), rg.end());
+    assert(std::ranges::equal(g, rg));
+    // insert_range, assign and input ranges
+    auto const list = {7uz, 8uz, 9uz};
+    assert(*g.insert_range(g.begin() + 10, list) == 7uz);
+    rg.insert(rg.begin() + 10, list);
+    assert(*g.insert(g.end() - 10, list.begin(), list.end()) == 7uz);
+    rg.insert(rg.end() - 10, list.begin(), list.end());
+    g.insert(g.begin() + 3, {4uz, 5uz});
+    rg.insert(rg.begin() + 3, {4uz, 5uz});
+    assert(std::ranges::equal(g, rg));
+    std::istringstream in{"1 2 3 4"};
+    g.prepend_range(std::views::istream<std::size_t>(in));
+    rg.insert(rg.begin(), {1uz, 2uz, 3uz, 4uz});
+    in.clear();
+    in.str("5 6");
+    g.insert_range(g.begin() + 2, std::views::istream<std::size_t>(in));
+    rg.insert(rg.begin() + 2, {5uz, 6uz});
+    assert(std::ranges::equal(g, rg));
+    g.assign(5uz, g[7uz]);
+    rg.assign(5uz, rg[7uz]);
+    assert(std::ranges::equal(g, rg));
+    g.assign(2000uz, g[1uz]);
+    rg.assign(2000uz, rg[1uz]);
+    assert(std::ranges::equal(g, rg));
+    g.assign(rg.begin(), rg.begin() + 4);
+    assert(std::ranges::equal(g, std::ranges::subrange(rg.begin(), rg.begin() + 4)));
+    g.assign_range(std::views::iota(0uz, 100uz));
+    assert(std::ranges::equal(g, std::views::iota(0uz, 100uz)));
+}
+
+void test_mapped_deque()
+{
+    auto const path = (std::filesystem::temp_directory_path() / "bizwen_mapped_deque_test").string();
+    std::filesystem::remove(path);
+    std::deque<std::uint64_t> r{};
+    void *old_base{};
+    void *old_mapping{};
+    {
+        bizwen::mapped_deque<std::uint64_t> m(path.c_str(), 64uz << 20);
+        old_base = &*m;
+        // the deque is stored in the first page of the mapping
+        auto const page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+        old_mapping = reinterpret_cast<void *>(reinterpret_cast<std::uintptr_t>(old_base) / page * page);
+        // only one mapped_deque may open the file at a time
+        auto locked = false;
+        try
+        {
+            bizwen::mapped_deque<std::uint64_t> second(path.c_str(), 0uz);
+        }
+        catch (std::system_error const &)
+        {
+            locked = true;
+        }
+        assert(locked);
+        for (auto i = 0uz; i != 100000uz; ++i)
+        {
+            m->push_back(i);
+            r.push_back(i);
+            if (i % 3uz == 0uz)
+            {
+                m->push_front(i);
+                r.push_front(i);
+            }
+        }
+        for (auto i = 0uz; i != 20000uz; ++i)
+        {
+            m->pop_front();
+            r.pop_front();
+        }
+        m.checkpoint();
+    }
+    {
+        // keeps the old address busy so that the file is mapped somewhere else
+        auto const size = std::filesystem::file_size(path);
+        auto const blocker = ::mmap(old_mapping, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        bizwen::mapped_deque<std::uint64_t> m(path.c_str(), 0uz);
+        // mmap treats the address only as a hint
+        assert(static_cast<void *>(&*m) != old_base || blocker != old_mapping);
+        assert(std::ranges::equal(*m, r));
+        // blocks freed at the front are reused
+        auto const unused = m.unused();
+        for (auto i = 0uz; i != 100000uz; ++i)
+        {
+            m->push_back(i);
+            m->pop_front();
+            r.push_back(i);
+            r.pop_front();
+        }
+        assert(std::ranges::equal(*m, r) && m.unused() + 65536uz >= unused);
+        m->insert(m->begin() + 5, 7uz);
+        r.insert(r.begin() + 5, 7uz);
+        m.checkpoint();
+        if (blocker != MAP_FAILED)
+        {
+            ::munmap(blocker, size);
+        }
+    }
+    {
+        bizwen::mapped_deque<std::uint64_t> m(path.c_str(), 0uz);
+        assert(std::ranges::equal(*m, r));
+        // sorting takes its scratch space from the heap, not from the arena
+        auto const unused = m.unused();
+        bizwen::sort(*m, std::greater<>{});
+        std::ranges::sort(r, std::greater<>{});
+        assert(std::ranges::equal(*m, r) && m.unused() == unused);
+    }
+    {
+        auto thrown = false;
+        try
+        {
+            bizwen::mapped_deque<std::uint32_t> wrong(path.c_str(), 0uz);
+        }
+        catch (std::runtime_error const &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    std::filesystem::remove(path);
+}
+
+void test_huge_page()
+{
+    {
+        bizwen::huge_page_resource r{};
+        // small allocations are carved from the same region and reused after deallocate
+        auto const a = r.allocate(4096uz, 8uz);
+        auto const b = r.allocate(4096uz, 8uz);
+        assert(reinterpret_cast<std::uintptr_t>(a) % 4096uz == 0uz);
+        assert(static_cast<std::byte *>(b) - static_cast<std::byte *>(a) == 4096);
+        r.deallocate(a, 4096uz);
+        assert(r.allocate(4000uz, 8uz) == a);
+        auto const c = r.allocate(24uz, 8uz);
+        assert(reinterpret_cast<std::uintptr_t>(c) % 32uz == 0uz);
+        // large allocations get their own 2 MiB aligned mapping
+        auto const d = r.allocate(3uz << 20, 8uz);
+        assert(reinterpret_cast<std::uintptr_t>(d) % (2uz << 20) == 0uz);
+        std::memset(d, 1, 3uz << 20);
+        r.deallocate(d, 3uz << 20);
+    }
+    {
+        bizwen::huge_page_resource r{};
+        bizwen::deque<std::uint64_t, bizwen::huge_page_allocator<std::uint64_t>> d(
+            bizwen::huge_page_allocator<std::uint64_t>{&r});
+        for (auto i = 0uz; i != 1000000uz; ++i)
+        {
+            d.push_back(i);
+        }
+        for (auto i = 0uz; i != 1000uz; ++i)
+        {
+            d.push_front(i);
+        }
+        assert(d.size() == 1001000uz && d[999uz] == 0uz && d[1000uz] == 0uz && d.back() == 999999uz);
+        assert(std::ranges::equal(d | std::views::drop(1000uz), std::views::iota(0uz, 1000000uz)));
+        d.shrink_to_fit();
+        auto copy = d;
+        assert(copy == d && copy.get_allocator() == d.get_allocator());
+    }
+    bizwen::deque<std::size_t, bizwen::huge_page_allocator<std::size_t>> g(1000uz, 7uz);
+    assert(g.get_allocator().resource() == &bizwen::huge_page_resource::global() && g[999uz] == 7uz);
+}
+#endif
+
+#if defined(__linux__)
+void test_magic_ring()
+{
+    bizwen::magic_ring<> ring{};
+    std::deque<char> r{};
+    auto const record = std::string_view("0123456789abcdefghijklmnopqrstuvwxyz");
+    // follows the offset of the first element inside the ring
+    auto head = 0uz;
+    auto capacity = 0uz;
+    auto wrapped = false;
+    for (auto i = 0uz; i != 20000uz; ++i)
+    {
+        ring.append_range(record.substr(0uz, i % record.size()));
+        r.insert(r.end(), record.begin(), record.begin() + static_cast<std::ptrdiff_t>(i % record.size()));
+        ring.push_back(static_cast<char>(i));
+        r.push_back(static_cast<char>(i));
+        if (ring.capacity() != capacity)
+        {
+            capacity = ring.capacity();
+            head = 0uz;
+        }
+        if (ring.size() > 3000uz)
+        {
+            auto const n = i % 1500uz;
+            // the readable region is contiguous even when it crosses the end of the ring
+            auto const front = ring.contiguous_front(n);
+            wrapped = wrapped || head + n > capacity;
+            head = (head + n) % capacity;
+            assert(std::ranges::equal(front, r | std::views::take(n)));
+            ring.pop_front(n);
+            r.erase(r.begin(), r.begin() + static_cast<std::ptrdiff_t>(n));
+        }
+    }
+    assert(wrapped && std::ranges::equal(ring, r));
+    auto copy = ring;
+    assert(copy == ring);
+    copy.shrink_to_fit();
+    assert(copy == ring && copy.capacity() >= ring.size());
+    auto const size = ring.size();
+    ring.append_range(std::string(100000uz, 'x'));
+    assert(ring.size() == size + 100000uz && ring.back() == 'x' && ring.at(size - 1uz) == r.back());
+    ring.pop_back(100000uz);
+    assert(std::ranges::equal(ring, r));
+    // the appended range is inside the ring that is replaced
+    auto fill = [&ring, &r] {
+        while (ring.size() != ring.capacity())
+        {
+            ring.push_back('y');
+            r.push_back('y');
+        }
+        return ring.capacity();
+    };
+    for (auto i = 0uz; i != 3uz; ++i)
+    {
+        auto capacity_before = fill();
+        ring.append(ring.contiguous_front(ring.size()));
+        auto const all = std::string(r.begin(), r.end());
+        r.insert(r.end(), all.begin(), all.end());
+        assert(ring.capacity() > capacity_before && std::ranges::equal(ring, r));
+        capacity_before = fill();
+        ring.append_range(ring.contiguous_front(100uz) | std::views::reverse);
+        auto const head = std::string(r.begin(), r.begin() + 100);
+        r.insert(r.end(), head.rbegin(), head.rend());
+        assert(ring.capacity() > capacity_before && std::ranges::equal(ring, r));
+    }
+    ring.clear();
+    ring.shrink_to_fit();
+    assert(ring.empty() && ring.capacity() == 0uz);
+}
+
+void test_shared_deque()
+{
+    auto const name = "/bizwen_shared_deque_test_" + std::to_string(::getpid());
+    bizwen::shared_deque<std::uint64_t>::remove(name.c_str());
+    constexpr auto count = 200000uz;
+    bizwen::shared_deque<std::uint64_t> q(name.c_str(), 16uz << 20);
+    {
+        auto l = q.lock();
+        // left for the child, which removes them before it pushes anything
+        for (auto i = 0uz; i != 1000uz; ++i)
+        {
+            l->push_back(count + i);
+        }
+    }
+    auto const pid = ::fork();
+    assert(pid != -1);
+    if (pid == 0)
+    {
+        // the inherited mapping keeps the old address busy, so the child maps the segment somewhere else
+        bizwen::shared_deque<std::uint64_t> c(name.c_str(), 0uz);
+        auto const inherited = &*q.lock();
+        auto ok = true;
+        {
+            auto l = c.lock();
+            ok = &*l != inherited && std::ranges::equal(*l, std::views::iota(count, count + 1000uz));
+            l->clear();
+        }
+        for (auto i = 0uz; i != count; i += 100uz)
+        {
+            auto l = c.lock();
+            for (auto j = i; j != i + 100uz; ++j)
+            {
+                l->push_back(j);
+            }
+            l.notify_all();
+        }
+        ::_exit(ok ? 0 : 1);
+    }
+    auto next = 0uz;
+    while (next != count)
+    {
+        auto l = q.lock();
+        l.wait([&l] { return !l->empty() && l->front() < count; });
+        for (; !l->empty(); l->pop_front())
+        {
+            assert(l->front() == next);
+            ++next;
+        }
+    }
+    int status{};
+    [[maybe_unused]] auto const waited = ::waitpid(pid, &status, 0);
+    assert(waited == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    assert(q.lock()->empty());
+    // a process that dies while holding the lock leaves the segment unusable
+    auto const dead = ::fork();
+    assert(dead != -1);
+    if (dead == 0)
+    {
+        auto l = q.lock();
+        l->push_back(1uz);
+        ::_exit(0);
+    }
+    [[maybe_unused]] auto const waited_dead = ::waitpid(dead, &status, 0);
+    assert(waited_dead == dead);
+    for (auto const expected : {EOWNERDEAD, ENOTRECOVERABLE})
+    {
+        auto error = 0;
+        try
+        {
+            q.lock();
+        }
+        catch (std::system_error const &e)
+        {
+            error = e.code().value();
+        }
+        assert(error == expected);
+    }
+    bizwen::shared_deque<std::uint64_t>::remove(name.c_str());
+    // a creator that failed to initialize the segment does not leave its name behind
+    auto created = false;
+    try
+    {
+        bizwen::shared_deque<std::uint64_t> huge(name.c_str(), std::numeric_limits<std::size_t>::max() / 2uz);
+        created = true;
+    }
+    catch (std::system_error const &)
+    {
+    }
+    [[maybe_unused]] auto const left = ::shm_open(name.c_str(), O_RDWR, 0600);
+    assert(created || left == -1);
+    if (left != -1)
+    {
+        ::close(left);
+        bizwen::shared_deque<std::uint64_t>::remove(name.c_str());
+    }
+    // a creator that died before it initialized the segment makes other openers time out
+    auto const fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    assert(fd != -1);
+    for (auto const size : {0, 1 << 20})
+    {
+        [[maybe_unused]] auto const truncated = ::ftruncate(fd, size);
+        assert(truncated == 0);
+        auto thrown = false;
+        try
+        {
+            bizwen::shared_deque<std::uint64_t> d(name.c_str(), 0uz);
+        }
+        catch (std::runtime_error const &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    ::close(fd);
+    bizwen::shared_deque<std::uint64_t>::remove(name.c_str());
+}
+#endif
+
+void test_dynamic_buffer(std::size_t front, std::size_t back)
+{
+    bizwen::deque<std::byte> d{};
+    std::deque<std::byte> r{};
+    for (auto i = 0uz; i != front; ++i)
+    {
+        d.push_front(std::byte(i));
+        r.push_front(std::byte(i));
+    }
+    for (auto i = 0uz; i != back; ++i)
+    {
+        d.push_back(std::byte(i * 7uz));
+        r.push_back(std::byte(i * 7uz));
+    }
+    bizwen::dynamic_buffer buffer(d);
+    auto seed = front * 31uz + back;
+    for (auto step = 0uz; step != 300uz; ++step)
+    {
+        seed = seed * 6364136223846793005uz + 1442695040888963407uz;
+        auto const n = (seed >> 33) % 3000uz;
+        auto spans = buffer.prepare(n);
+        auto total = 0uz;
+        for (auto const s : spans)
+        {
+            for (auto &b : s)
+            {
+                b = std::byte(step + total++);
+            }
+        }
+        assert(total == n && buffer.capacity() >= buffer.size() + n);
+        // only a part of the prepared bytes may be committed
+        auto const committed = step % 3uz == 0uz ? n / 2uz : n;
+        buffer.commit(committed);
+        for (auto i = 0uz; i != committed; ++i)
+        {
+            r.push_back(std::byte(step + i));
+        }
+        assert(std::ranges::equal(d, r) && buffer.size() == r.size());
+        auto const consumed = (seed >> 17) % 4000uz;
+        buffer.consume(consumed);
+        r.erase(r.begin(), r.begin() + static_cast<std::ptrdiff_t>((std::min)(consumed, r.size())));
+        auto read = 0uz;
+        for (auto const s : buffer.data())
+        {
+            assert(std::ranges::equal(s, r | std::views::drop(read) | std::views::take(s.size())));
+            read += s.size();
+        }
+        assert(read == r.size() && std::ranges::equal(d, r));
+    }
+    bizwen::dynamic_buffer limited(d, d.size() + 10uz);
+    auto thrown = false;
+    try
+    {
+        limited.prepare(11uz);
+    }
+    catch (std::length_error const &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    buffer.consume(d.size() + 1uz);
+    assert(d.empty());
+}
+
+void test_split_records(std::size_t front, std::size_t back)
+{
+    // lines of every length from 0 to 9000, so that some straddle one or more blocks
+    bizwen::deque<char> d{};
+    std::vector<std::string> lines{};
+    auto seed = front + back;
+    std::string text{};
+    for (auto i = 0uz; i != front + back; ++i)
+    {
+        seed = seed * 6364136223846793005uz + 1442695040888963407uz;
+        auto const length = (seed >> 33) % (i % 7uz == 0uz ? 9000uz : 90uz);
+        lines.push_back(std::string(length, static_cast<char>('a' + i % 26uz)));
+        text += lines.back();
+        text += '\n';
+    }
+    // the last record has no delimiter yet
+    text += "partial";
+    std::vector<std::string> result{};
+    for (auto i = 0uz; i < text.size(); i += 1000uz)
+    {
+        auto const chunk = std::string_view(text).substr(i, 1000uz);
+        if (i % 2000uz == 0uz)
+        {
+            d.append_range(chunk);
+        }
+        else
+        {
+            // leaves free space at the front of the first block
+            d.insert(d.end(), chunk.begin(), chunk.end());
+        }
+        for (auto const record : bizwen::split_records(d))
+        {
+            result.emplace_back(record);
+        }
+    }
+    assert(result == lines);
+    assert(std::ranges::equal(d, std::string_view("partial")));
+    d.append_range(std::string_view(";x;;y"));
+    auto records = bizwen::split_records(d, ';');
+    auto it = records.begin();
+    assert(*it == "partial");
+    ++it;
+    assert(*it == "x");
+    ++it;
+    assert(*it == "");
+    ++it;
+    assert(it == records.end() && std::ranges::equal(d, std::string_view("y")));
+    {
+        // records that were handed out are removed when the splitter is destroyed
+        d.append_range(std::string_view("1\n2\n3\n"));
+        for (auto const record : bizwen::split_records(d))
+        {
+            if (record == "y1")
+            {
+                break;
+            }
+        }
+        assert(std::ranges::equal(d, std::string_view("2\n3\n")));
+    }
+    {
+        // the splitter is movable, so it can be passed to range adaptors
+        d.append_range(std::string_view("4\n"));
+        std::vector<std::string> taken{};
+        for (auto const record : bizwen::split_records(d) | std::views::take(2uz))
+        {
+            taken.emplace_back(record);
+        }
+        assert((taken == std::vector<std::string>{"2", "3"}) && std::ranges::equal(d, std::string_view("4\n")));
+        // a moved-from splitter no longer touches the deque
+        auto a = bizwen::split_records(d);
+        auto b = std::move(a);
+        assert(*b.begin() == "4");
+    }
+    assert(d.empty());
+}
+
+void test_serialize(std::size_t front, std::size_t back)
+{
+    bizwen::deque<std::uint32_t> d{};
+    for (auto i = 0uz; i != front; ++i)
+    {
+        d.push_front(static_cast<std::uint32_t>(i * 3uz));
+    }
+    for (auto i = 0uz; i != back; ++i)
+    {
+        d.push_back(static_cast<std::uint32_t>(i * 5uz));
+    }
+    std::stringstream stream{};
+    bizwen::write(stream, d);
+    assert(stream.str().size() == 24uz + d.size() * 4uz);
+    // the target already holds elements, which are replaced
+    bizwen::deque<std::uint32_t> r(700uz);
+    bizwen::read(stream, r);
+    assert(r == d);
+    // a different element size is rejected
+    bizwen::deque<std::uint16_t> wrong{};
+    stream.clear();
+    stream.seekg(0);
+    auto thrown = false;
+    try
+    {
+        bizwen::read(stream, wrong);
+    }
+    catch (std::runtime_error const &)
+    {
+        thrown = true;
+    }
+    assert(thrown && wrong.empty());
+    // truncated data
+    std::stringstream truncated(stream.str().substr(0uz, stream.str().size() - 1uz));
+    thrown = false;
+    try
+    {
+        bizwen::read(truncated, r);
+    }
+    catch (std::runtime_error const &)
+    {
+        thrown = true;
+    }
+    assert(thrown && r.empty());
+    {
+        // a stream that accepts only 100 bytes fails once the data does not fit
+        struct fixed_buffer : std::streambuf
+        {
+            std::array<char, 100uz> storage{};
+
+            fixed_buffer()
+            {
+                setp(storage.data(), storage.data() + storage.size());
+            }
+        } buffer{};
+        std::ostream limited(&buffer);
+        thrown = false;
+        try
+        {
+            bizwen::write(limited, d);
+        }
+        catch (std::runtime_error const &)
+        {
+            thrown = true;
+        }
+        assert(thrown == (24uz + d.size() * 4uz > 100uz));
+    }
+#if __has_include(<sys/uio.h>)
+    auto const file = std::tmpfile();
+    bizwen::write(fileno(file), d);
+    bizwen::write(fileno(file), r);
+    std::rewind(file);
+    bizwen::deque<std::uint32_t> f{};
+    bizwen::read(fileno(file), f);
+    assert(f == d);
+    bizwen::read(fileno(file), f);
+    assert(f.empty());
+    std::fclose(file);
+#endif
+}
+#endif
+
+int main()
+{
+    test_all<vsn<1uz>>();
+    test_all<vsn<2uz>>();
+    test_all<vsn<3uz>>();
+    test_all<vsn<4uz>>();
+    test_all<vsn<5uz>>();
+    test_all<vsn<6uz>>();
+    test_all<vsn<7uz>>();
+    test_all<vsn<8uz>>();
+    test_all<vsn<9uz>>();
+#if defined(TEST_FUNC)
+    for (auto x = 0; x < 100000; ++x)
+        test_buckets(x);
+    test_ctrl_growth();
+    for (auto thieves = 0uz; thieves != 5uz; ++thieves)
+        test_ws_deque(thieves, 1000000uz);
+    test_spsc_deque(1000000uz);
+    for (auto threads : {1uz, 2uz, 4uz, 8uz})
+    {
+        test_concurrent_queue(threads, 1000uz, 100000uz);
+        test_concurrent_queue(threads, std::numeric_limits<std::size_t>::max(), 100000uz);
+    }
+    for (auto producers : {1uz, 3uz})
+    {
+        for (auto capacity : {0uz, 1uz, 7uz, 1000uz})
+        {
+            test_async_channel(producers, capacity, 10000uz);
+        }
+    }
+    for (auto threads : {1uz, 4uz})
+    {
+        bizwen::parallel::thread_pool pool(threads);
+        for (auto front : {0uz, 1uz, 700uz, 5000uz})
+        {
+            for (auto back : {0uz, 1uz, 511uz, 512uz, 100000uz})
+            {
+                test_parallel(pool, front, back);
+                test_sort(pool, front, back);
+            }
+        }
+    }
+    for (auto window : {1uz, 2uz, 511uz, 512uz, 513uz, 5000uz})
+    {
+        test_sliding_window(window);
+        test_fifo(window);
+    }
+#if __has_include(<sys/mman.h>)
+    test_vm_deque();
+    test_mapped_deque();
+    test_huge_page();
+#endif
+#if defined(__linux__)
+    test_magic_ring();
+    test_shared_deque();
+#endif
+    for (auto front : {0uz, 1uz, 700uz})
+    {
+        for (auto back : {0uz, 1uz, 511uz, 512uz, 5000uz})
+        {
+            test_binary_search(front, back);
+            test_find<unsigned char>(front, back);
+            test_find<std::int16_t>(front, back);
+            test_find<std::int32_t>(front, back);
+            test_find<std::uint64_t>(front, back);
+            test_find<float>(front, back);
+            test_find<double>(front, back);
+            test_search(front, back);
+            test_reduce<std::int32_t>(front, back);
+            test_reduce<std::int64_t>(front, back);
+            test_reduce<float>(front, back);
+            test_reduce<double>(front, back);
+            test_compare<char>(front, back);
+            test_compare<unsigned char>(front, back);
+            test_compare<std::int32_t>(front, back);
+            test_compare<double>(front, back);
+            test_hash(front, back);
+            test_erase(front, back);
+            test_erase_indices(front, back);
+            test_insert_many(front, back);
+            test_dynamic_buffer(front, back);
+            test_split_records(front, back);
+            test_serialize(front, back);
+            test_parallel_copy<std::size_t>(front, back);
+            test_parallel_copy<std::string>(front, back);
+        }
+    }
 #endif
 }
@@ -0,0 +1,928 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_VM_DEQUE_HPP)
+#define BIZWEN_VM_DEQUE_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// assert
+#include <cassert>
+// size_t/ptrdiff_t/byte
+#include <cstddef>
+// uintptr_t
+#include <cstdint>
+// lexicographical_compare_three_way/equal/rotate/fill/max/min
+#include <algorithm>
+// bad_alloc
+#include <new>
+// initializer_list
+#include <initializer_list>
+// reverse_iterator/input_iterator/make_move_iterator
+#include <iterator>
+// construct_at/destroy_at/destroy
+#include <memory>
+// single_view/subrange/input_range/distance
+#include <ranges>
+// span
+#include <span>
+// out_of_range/length_error
+#include <stdexcept>
+// is_nothrow_move_constructible
+#include <type_traits>
+// move/forward/exchange/swap
+#include <utility>
+
+// mmap/mprotect/madvise/munmap
+#include <sys/mman.h>
+// sysconf
+#include <unistd.h>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+// 基于虚拟内存的连续deque，仅用于POSIX系统
+// 构造时只保留一段虚拟地址，元素从中间开始，向两端增长时按需用mprotect提交页，因此不需要控制块，
+// 迭代器是指针，operator[]只是一次加法，增长时不移动元素，引用保持稳定
+// 只有一端到达保留范围的边界时，才把元素整体移回中间，这会使引用失效
+// shrink_to_fit用madvise(MADV_DONTNEED)归还元素范围之外的页
+// 移回中间时逐个移动元素，无法回滚，因此要求移动构造不抛出异常
+BIZWEN_EXPORT template <typename T>
+    requires ::std::is_nothrow_move_constructible_v<T>
+class vm_deque
+{
+  public:
+    using value_type = T;
+    using size_type = ::std::size_t;
+    using difference_type = ::std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = T const &;
+    using pointer = T *;
+    using const_pointer = T const *;
+    using iterator = T *;
+    using const_iterator = T const *;
+    using reverse_iterator = ::std::reverse_iterator<iterator>;
+    using const_reverse_iterator = ::std::reverse_iterator<const_iterator>;
+
+    // 默认在64位平台上保留16GiB的虚拟地址，在32位平台上保留256MiB
+    static constexpr ::std::size_t default_reserve_bytes = ::std::size_t(1) << (sizeof(void *) >= 8u ? 34 : 28);
+
+  private:
+    static_assert(alignof(T) <= 4096);
+
+    // 保留的虚拟地址范围，第一次增长时才保留
+    ::std::byte *base_{};
+    ::std::size_t reserved_{default_reserve_bytes};
+    // 已提交的页，总是包含元素范围
+    ::std::byte *commit_begin_{};
+    ::std::byte *commit_end_{};
+    T *begin_{};
+    T *end_{};
+
+    static ::std::size_t page_size_() noexcept
+    {
+        static ::std::size_t const size = static_cast<::std::size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    static ::std::byte *page_floor_(void *const p) noexcept
+    {
+        auto const address = reinterpret_cast<::std::uintptr_t>(p);
+        return reinterpret_cast<::std::byte *>(address - address % page_size_());
+    }
+
+    static ::std::byte *page_ceil_(void *const p) noexcept
+    {
+        return page_floor_(static_cast<::std::byte *>(p) + (page_size_() - ::std::size_t(1)));
+    }
+
+    ::std::byte *reserve_end_() const noexcept
+    {
+        return base_ + reserved_;
+    }
+
+    // 返回以中间为中心放置count个元素时的首元素位置
+    T *center_(::std::size_t const count) const noexcept
+    {
+        auto const offset = (reserved_ - count * sizeof(T)) / ::std::size_t(2);
+        return reinterpret_cast<T *>(base_ + (offset - offset % alignof(T)));
+    }
+
+    void reserve_vm_()
+    {
+        if (base_ != nullptr)
+        {
+            return;
+        }
+        auto flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_NORESERVE)
+        flags |= MAP_NORESERVE;
+#endif
+        reserved_ = (reserved_ + page_size_() - ::std::size_t(1)) / page_size_() * page_size_();
+        auto const p = ::mmap(nullptr, reserved_, PROT_NONE, flags, -1, 0);
+        if (p == MAP_FAILED)
+        {
+            throw ::std::bad_alloc{};
+        }
+        base_ = static_cast<::std::byte *>(p);
+        begin_ = center_(::std::size_t(0));
+        end_ = begin_;
+        commit_begin_ = page_floor_(begin_);
+        commit_end_ = commit_begin_;
+    }
+
+    static void protect_(::std::byte *const first, ::std::byte *const last, int const prot)
+    {
+        if (first != last && ::mprotect(first, static_cast<::std::size_t>(last - first), prot) != 0)
+        {
+            throw ::std::bad_alloc{};
+        }
+    }
+
+    // 已提交的页至少翻倍，至少提交64KiB
+    ::std::size_t grow_bytes_(::std::size_t const need) const noexcept
+    {
+        auto const bytes = (::std::max)({need, static_cast<::std::size_t>(commit_end_ - commit_begin_),
+                                         ::std::size_t(1) << 16});
+        return (bytes + page_size_() - ::std::size_t(1)) / page_size_() * page_size_();
+    }
+
+    // 把元素整体移到dst，移动过程中源和目标可以重叠
+    void relocate_(T *const dst) noexcept
+    {
+        auto const count = size();
+        if (dst < begin_)
+        {
+            for (auto i = ::std::size_t(0); i != count; ++i)
+            {
+                ::std::construct_at(dst + i, ::std::move(begin_[i]));
+                ::std::destroy_at(begin_ + i);
+            }
+        }
+        else if (dst > begin_)
+        {
+            for (auto i = count; i != ::std::size_t(0); --i)
+            {
+                ::std::construct_at(dst + (i - ::std::size_t(1)), ::std::move(begin_[i - ::std::size_t(1)]));
+                ::std::destroy_at(begin_ + (i - ::std::size_t(1)));
+            }
+        }
+        begin_ = dst;
+        end_ = dst + count;
+    }
+
+    // 一端到达保留范围的边界时把元素移回中间
+    void recenter_(::std::size_t const add)
+    {
+        auto const count = size();
+        if ((count + add) * sizeof(T) > reserved_ / ::std::size_t(2))
+        {
+            throw ::std::length_error("vm_deque: reserved address space exhausted");
+        }
+        auto const dst = center_(count);
+        // 目标范围和已提交的页连成一段
+        auto const first = (::std::min)(page_floor_(dst), commit_begin_);
+        auto const last = (::std::max)(page_ceil_(dst + count), commit_end_);
+        protect_(first, commit_begin_, PROT_READ | PROT_WRITE);
+        commit_begin_ = first;
+        protect_(commit_end_, last, PROT_READ | PROT_WRITE);
+        commit_end_ = last;
+        relocate_(dst);
+    }
+
+    // 为末尾添加add个元素时是否需要移回中间，参数引用本容器的元素时需要先复制
+    bool back_full_(::std::size_t const add) const noexcept
+    {
+        return base_ != nullptr &&
+               static_cast<::std::size_t>(reserve_end_() - reinterpret_cast<::std::byte *>(end_)) < add * sizeof(T);
+    }
+
+    bool front_full_(::std::size_t const add) const noexcept
+    {
+        return base_ != nullptr &&
+               static_cast<::std::size_t>(reinterpret_cast<::std::byte *>(begin_) - base_) < add * sizeof(T);
+    }
+
+    void reserve_back_(::std::size_t const add)
+    {
+        reserve_vm_();
+        if (back_full_(add))
+        {
+            recenter_(add);
+        }
+        auto const need = reinterpret_cast<::std::byte *>(end_ + add);
+        if (need <= commit_end_)
+        {
+            return;
+        }
+        auto const last =
+            commit_end_ + (::std::min)(grow_bytes_(static_cast<::std::size_t>(need - commit_end_)),
+                                       static_cast<::std::size_t>(reserve_end_() - commit_end_));
+        protect_(commit_end_, last, PROT_READ | PROT_WRITE);
+        commit_end_ = last;
+    }
+
+    void reserve_front_(::std::size_t const add)
+    {
+        reserve_vm_();
+        if (front_full_(add))
+        {
+            recenter_(add);
+        }
+        auto const need = reinterpret_cast<::std::byte *>(begin_ - add);
+        if (need >= commit_begin_)
+        {
+            return;
+        }
+        auto const first =
+            commit_begin_ - (::std::min)(grow_bytes_(static_cast<::std::size_t>(commit_begin_ - need)),
+                                         static_cast<::std::size_t>(commit_begin_ - base_));
+        protect_(first, commit_begin_, PROT_READ | PROT_WRITE);
+        commit_begin_ = first;
+    }
+
+    // 在元素范围之外的[first, last)中构造，异常时销毁已经构造的元素
+    struct construct_guard_
+    {
+        T *first;
+        T *last;
+
+        ~construct_guard_()
+        {
+            ::std::destroy(first, last);
+        }
+    };
+
+    static auto move_range_(vm_deque &d) noexcept
+    {
+        return ::std::ranges::subrange(::std::make_move_iterator(d.begin_), ::std::make_move_iterator(d.end_));
+    }
+
+    // 调用者已经保留了空间，在末尾构造rg中的元素
+    template <typename R>
+    void append_reserved_(R &&rg)
+    {
+        construct_guard_ guard{end_, end_};
+        for (auto &&e : rg)
+        {
+            ::std::construct_at(guard.last, ::std::forward<decltype(e)>(e)); // may throw
+            ++guard.last;
+        }
+        end_ = guard.last;
+        guard.first = guard.last;
+    }
+
+    template <typename R>
+    void prepend_reserved_(R &&rg, ::std::size_t const count)
+    {
+        construct_guard_ guard{begin_ - count, begin_ - count};
+        for (auto &&e : rg)
+        {
+            ::std::construct_at(guard.last, ::std::forward<decltype(e)>(e)); // may throw
+            ++guard.last;
+        }
+        assert(guard.last == begin_);
+        begin_ = guard.first;
+        guard.last = guard.first;
+    }
+
+    void fill_back_(::std::size_t const count, T const &value)
+    {
+        construct_guard_ guard{end_, end_};
+        for (; guard.last != end_ + count; ++guard.last)
+        {
+            ::std::construct_at(guard.last, value); // may throw
+        }
+        end_ = guard.last;
+        guard.first = guard.last;
+    }
+
+    void fill_front_(::std::size_t const count, T const &value)
+    {
+        construct_guard_ guard{begin_ - count, begin_ - count};
+        for (; guard.last != begin_; ++guard.last)
+        {
+            ::std::construct_at(guard.last, value); // may throw
+        }
+        begin_ = guard.first;
+        guard.last = guard.first;
+    }
+
+    // value可能是本容器的元素，需要移回中间时先复制
+    void append_fill_(::std::size_t const count, T const &value)
+    {
+        if (back_full_(count))
+        {
+            T const temp(value);
+            reserve_back_(count);
+            fill_back_(count, temp);
+            return;
+        }
+        reserve_back_(count);
+        fill_back_(count, value);
+    }
+
+    void prepend_fill_(::std::size_t const count, T const &value)
+    {
+        if (front_full_(count))
+        {
+            T const temp(value);
+            reserve_front_(count);
+            fill_front_(count, temp);
+            return;
+        }
+        reserve_front_(count);
+        fill_front_(count, value);
+    }
+
+    void release_() noexcept
+    {
+        clear();
+        if (base_ != nullptr)
+        {
+            ::munmap(base_, reserved_);
+        }
+        base_ = nullptr;
+        commit_begin_ = nullptr;
+        commit_end_ = nullptr;
+        begin_ = nullptr;
+        end_ = nullptr;
+    }
+
+  public:
+    vm_deque() noexcept = default;
+
+    // 保留至少bytes字节的虚拟地址，元素最多占用其中的一半
+    struct reservation
+    {
+        ::std::size_t bytes;
+    };
+
+    explicit vm_deque(reservation const r) noexcept : reserved_(r.bytes)
+    {
+    }
+
+    explicit vm_deque(size_type const count)
+    {
+        resize(count);
+    }
+
+    vm_deque(size_type const count, T const &value)
+    {
+        resize(count, value);
+    }
+
+    template <::std::input_iterator U, typename V>
+    vm_deque(U first, V last)
+    {
+        for (; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+    }
+
+    vm_deque(::std::initializer_list<T> const ilist) : vm_deque(ilist.begin(), ilist.end())
+    {
+    }
+
+    vm_deque(vm_deque const &other) : reserved_(other.reserved_)
+    {
+        reserve_back_(other.size());
+        for (auto const &e : other)
+        {
+            emplace_back(e);
+        }
+    }
+
+    vm_deque(vm_deque &&other) noexcept
+        : base_(::std::exchange(other.base_, nullptr)), reserved_(other.reserved_),
+          commit_begin_(::std::exchange(other.commit_begin_, nullptr)),
+          commit_end_(::std::exchange(other.commit_end_, nullptr)), begin_(::std::exchange(other.begin_, nullptr)),
+          end_(::std::exchange(other.end_, nullptr))
+    {
+    }
+
+    vm_deque &operator=(vm_deque const &other)
+    {
+        if (this != &other)
+        {
+            vm_deque temp(other);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    vm_deque &operator=(vm_deque &&other) noexcept
+    {
+        vm_deque temp(::std::move(other));
+        swap(temp);
+        return *this;
+    }
+
+    ~vm_deque()
+    {
+        release_();
+    }
+
+    void swap(vm_deque &other) noexcept
+    {
+        using ::std::swap;
+        swap(base_, other.base_);
+        swap(reserved_, other.reserved_);
+        swap(commit_begin_, other.commit_begin_);
+        swap(commit_end_, other.commit_end_);
+        swap(begin_, other.begin_);
+        swap(end_, other.end_);
+    }
+
+    friend void swap(vm_deque &lhs, vm_deque &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    size_type size() const noexcept
+    {
+        return static_cast<size_type>(end_ - begin_);
+    }
+
+    bool empty() const noexcept
+    {
+        return begin_ == end_;
+    }
+
+    size_type max_size() const noexcept
+    {
+        return reserved_ / ::std::size_t(2) / sizeof(T);
+    }
+
+    T *data() noexcept
+    {
+        return begin_;
+    }
+
+    T const *data() const noexcept
+    {
+        return begin_;
+    }
+
+    iterator begin() noexcept
+    {
+        return begin_;
+    }
+
+    iterator end() noexcept
+    {
+        return end_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return begin_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return end_;
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin_;
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end_;
+    }
+
+    reverse_iterator rbegin() noexcept
+    {
+        return reverse_iterator(end_);
+    }
+
+    reverse_iterator rend() noexcept
+    {
+        return reverse_iterator(begin_);
+    }
+
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return const_reverse_iterator(end_);
+    }
+
+    const_reverse_iterator rend() const noexcept
+    {
+        return const_reverse_iterator(begin_);
+    }
+
+    const_reverse_iterator crbegin() const noexcept
+    {
+        return rbegin();
+    }
+
+    const_reverse_iterator crend() const noexcept
+    {
+        return rend();
+    }
+
+    // 只有一个桶
+    ::std::ranges::single_view<::std::span<T>> buckets() noexcept
+    {
+        return ::std::ranges::single_view<::std::span<T>>(::std::span<T>(begin_, end_));
+    }
+
+    ::std::ranges::single_view<::std::span<T const>> buckets() const noexcept
+    {
+        return ::std::ranges::single_view<::std::span<T const>>(::std::span<T const>(begin_, end_));
+    }
+
+    T &operator[](size_type const pos) noexcept
+    {
+        assert(pos < size());
+        return begin_[pos];
+    }
+
+    T const &operator[](size_type const pos) const noexcept
+    {
+        assert(pos < size());
+        return begin_[pos];
+    }
+
+    T &at(size_type const pos)
+    {
+        if (pos >= size())
+        {
+            throw ::std::out_of_range("vm_deque::at");
+        }
+        return begin_[pos];
+    }
+
+    T const &at(size_type const pos) const
+    {
+        if (pos >= size())
+        {
+            throw ::std::out_of_range("vm_deque::at");
+        }
+        return begin_[pos];
+    }
+
+    T &front() noexcept
+    {
+        assert(!empty());
+        return *begin_;
+    }
+
+    T const &front() const noexcept
+    {
+        assert(!empty());
+        return *begin_;
+    }
+
+    T &back() noexcept
+    {
+        assert(!empty());
+        return *(end_ - 1);
+    }
+
+    T const &back() const noexcept
+    {
+        assert(!empty());
+        return *(end_ - 1);
+    }
+
+    // 不需要移回中间时增长不移动元素
+    // 需要移回中间时参数可能引用本容器的元素，因此先构造到临时对象中
+    template <typename... V>
+    T &emplace_back(V &&...v)
+    {
+        if (back_full_(::std::size_t(1)))
+        {
+            T temp(::std::forward<V>(v)...); // may throw
+            reserve_back_(::std::size_t(1));
+            ::std::construct_at(end_, ::std::move(temp));
+            return *end_++;
+        }
+        reserve_back_(::std::size_t(1));
+        ::std::construct_at(end_, ::std::forward<V>(v)...); // may throw
+        return *end_++;
+    }
+
+    template <typename... V>
+    T &emplace_front(V &&...v)
+    {
+        if (front_full_(::std::size_t(1)))
+        {
+            T temp(::std::forward<V>(v)...); // may throw
+            reserve_front_(::std::size_t(1));
+            ::std::construct_at(begin_ - 1, ::std::move(temp));
+            return *--begin_;
+        }
+        reserve_front_(::std::size_t(1));
+        ::std::construct_at(begin_ - 1, ::std::forward<V>(v)...); // may throw
+        return *--begin_;
+    }
+
+    // 异常时元素不变
+    template <::std::ranges::input_range R>
+        requires ::std::convertible_to<::std::ranges::range_value_t<R>, T>
+    void append_range(R &&rg)
+    {
+        if constexpr (!::std::ranges::forward_range<R>)
+        {
+            // 元素个数未知，先收集到临时容器中
+            vm_deque temp(reservation{reserved_});
+            for (auto &&e : rg)
+            {
+                temp.emplace_back(::std::forward<decltype(e)>(e));
+            }
+            reserve_back_(temp.size());
+            append_reserved_(move_range_(temp));
+        }
+        else
+        {
+            auto const count = static_cast<::std::size_t>(::std::ranges::distance(rg));
+            if (back_full_(count))
+            {
+                // rg可能引用本容器的元素，移回中间之后就失效了，因此先复制
+                vm_deque temp(reservation{reserved_});
+                temp.reserve_back_(count);
+                temp.append_reserved_(rg);
+                reserve_back_(count);
+                append_reserved_(move_range_(temp));
+                return;
+            }
+            reserve_back_(count);
+            append_reserved_(rg);
+        }
+    }
+
+    // 保持rg中元素的顺序，异常时元素不变
+    template <::std::ranges::input_range R>
+        requires ::std::convertible_to<::std::ranges::range_value_t<R>, T>
+    void prepend_range(R &&rg)
+    {
+        if constexpr (!::std::ranges::forward_range<R>)
+        {
+            vm_deque temp(reservation{reserved_});
+            for (auto &&e : rg)
+            {
+                temp.emplace_back(::std::forward<decltype(e)>(e));
+            }
+            reserve_front_(temp.size());
+            prepend_reserved_(move_range_(temp), temp.size());
+        }
+        else
+        {
+            auto const count = static_cast<::std::size_t>(::std::ranges::distance(rg));
+            if (front_full_(count))
+            {
+                vm_deque temp(reservation{reserved_});
+                temp.reserve_back_(count);
+                temp.append_reserved_(rg);
+                reserve_front_(count);
+                prepend_reserved_(move_range_(temp), count);
+                return;
+            }
+            reserve_front_(count);
+            prepend_reserved_(rg, count);
+        }
+    }
+
+    template <::std::ranges::input_range R>
+        requires ::std::convertible_to<::std::ranges::range_value_t<R>, T>
+    void assign_range(R &&rg)
+    {
+        clear();
+        append_range(::std::forward<R>(rg));
+    }
+
+    void assign(size_type const count, T const &value)
+    {
+        if (count <= size())
+        {
+            ::std::fill(begin_, begin_ + count, value);
+            erase(begin_ + count, end_);
+            return;
+        }
+        ::std::fill(begin_, end_, value);
+        append_fill_(count - size(), value);
+    }
+
+    template <::std::input_iterator U, typename V>
+    void assign(U first, V last)
+    {
+        assign_range(::std::ranges::subrange(::std::move(first), ::std::move(last)));
+    }
+
+    void assign(::std::initializer_list<T> const ilist)
+    {
+        assign_range(ilist);
+    }
+
+    void push_back(T const &value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value)
+    {
+        emplace_back(::std::move(value));
+    }
+
+    void push_front(T const &value)
+    {
+        emplace_front(value);
+    }
+
+    void push_front(T &&value)
+    {
+        emplace_front(::std::move(value));
+    }
+
+    void pop_back() noexcept
+    {
+        assert(!empty());
+        ::std::destroy_at(--end_);
+    }
+
+    void pop_front() noexcept
+    {
+        assert(!empty());
+        ::std::destroy_at(begin_++);
+    }
+
+    template <typename... V>
+    iterator emplace(const_iterator const pos, V &&...v)
+    {
+        auto const front_diff = pos - begin_;
+        if (front_diff >= end_ - pos)
+        {
+            emplace_back(::std::forward<V>(v)...);
+            ::std::rotate(begin_ + front_diff, end_ - 1, end_);
+        }
+        else
+        {
+            emplace_front(::std::forward<V>(v)...);
+            ::std::rotate(begin_, begin_ + 1, begin_ + front_diff + 1);
+        }
+        return begin_ + front_diff;
+    }
+
+    iterator insert(const_iterator const pos, T const &value)
+    {
+        return emplace(pos, value);
+    }
+
+    iterator insert(const_iterator const pos, T &&value)
+    {
+        return emplace(pos, ::std::move(value));
+    }
+
+    // 在较近的一端添加元素，然后旋转到pos
+    template <::std::ranges::input_range R>
+        requires ::std::convertible_to<::std::ranges::range_value_t<R>, T>
+    iterator insert_range(const_iterator const pos, R &&rg)
+    {
+        auto const front_diff = pos - begin_;
+        auto const old_size = size();
+        if (front_diff >= end_ - pos)
+        {
+            append_range(::std::forward<R>(rg));
+            ::std::rotate(begin_ + front_diff, begin_ + old_size, end_);
+        }
+        else
+        {
+            prepend_range(::std::forward<R>(rg));
+            auto const count = size() - old_size;
+            ::std::rotate(begin_, begin_ + count, begin_ + count + front_diff);
+        }
+        return begin_ + front_diff;
+    }
+
+    template <::std::input_iterator U, typename V>
+    iterator insert(const_iterator const pos, U first, V last)
+    {
+        return insert_range(pos, ::std::ranges::subrange(::std::move(first), ::std::move(last)));
+    }
+
+    iterator insert(const_iterator const pos, ::std::initializer_list<T> const ilist)
+    {
+        return insert_range(pos, ilist);
+    }
+
+    iterator insert(const_iterator const pos, size_type const count, T const &value)
+    {
+        auto const front_diff = pos - begin_;
+        auto const old_size = size();
+        if (front_diff >= end_ - pos)
+        {
+            append_fill_(count, value);
+            ::std::rotate(begin_ + front_diff, begin_ + old_size, end_);
+        }
+        else
+        {
+            prepend_fill_(count, value);
+            ::std::rotate(begin_, begin_ + count, begin_ + count + front_diff);
+        }
+        return begin_ + front_diff;
+    }
+
+    iterator erase(const_iterator const pos) noexcept(::std::is_nothrow_move_assignable_v<T>)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator const first, const_iterator const last) noexcept(
+        ::std::is_nothrow_move_assignable_v<T>)
+    {
+        auto const f = begin_ + (first - begin_);
+        auto const l = begin_ + (last - begin_);
+        if (f - begin_ <= end_ - l)
+        {
+            auto const new_begin = ::std::move_backward(begin_, f, l);
+            ::std::destroy(begin_, new_begin);
+            begin_ = new_begin;
+            return l;
+        }
+        auto const new_end = ::std::move(l, end_, f);
+        ::std::destroy(new_end, end_);
+        end_ = new_end;
+        return f;
+    }
+
+    void clear() noexcept
+    {
+        ::std::destroy(begin_, end_);
+        end_ = begin_;
+    }
+
+    void resize(size_type const count)
+    {
+        if (count < size())
+        {
+            erase(begin_ + count, end_);
+            return;
+        }
+        reserve_back_(count - size());
+        while (size() != count)
+        {
+            emplace_back();
+        }
+    }
+
+    void resize(size_type const count, T const &value)
+    {
+        if (count < size())
+        {
+            erase(begin_ + count, end_);
+            return;
+        }
+        append_fill_(count - size(), value);
+    }
+
+    // 归还元素范围之外的已提交页，地址保留不变
+    void shrink_to_fit() noexcept
+    {
+        if (base_ == nullptr)
+        {
+            return;
+        }
+        auto const first = (::std::min)(page_floor_(begin_), commit_end_);
+        auto const last = (::std::max)(page_ceil_(end_), first);
+        for (auto const &[b, e] : {::std::pair{commit_begin_, first}, ::std::pair{last, commit_end_}})
+        {
+            if (b < e)
+            {
+                ::madvise(b, static_cast<::std::size_t>(e - b), MADV_DONTNEED);
+                ::mprotect(b, static_cast<::std::size_t>(e - b), PROT_NONE);
+            }
+        }
+        commit_begin_ = first;
+        commit_end_ = last;
+    }
+
+    bool operator==(vm_deque const &other) const
+    {
+        return ::std::equal(begin_, end_, other.begin_, other.end_);
+    }
+
+    auto operator<=>(vm_deque const &other) const
+    {
+        return ::std::lexicographical_compare_three_way(begin_, end_, other.begin_, other.end_);
+    }
+};
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif
@@ -0,0 +1,275 @@
+// Copyright 2025-2026 YexuanXiao
+// Distributed under the MIT License.
+// https://github.com/YexuanXiao/deque
+
+#if !defined(BIZWEN_WS_DEQUE_HPP)
+#define BIZWEN_WS_DEQUE_HPP
+
+#pragma push_macro("BIZWEN_EXPORT")
+#undef BIZWEN_EXPORT
+
+#if !defined(BIZWEN_MODULE)
+#define BIZWEN_EXPORT
+
+// block_elements_v/cache_line_size_v
+#include "./deque.hpp"
+// assert
+#include <cassert>
+// ptrdiff_t/size_t
+#include <cstddef>
+// atomic/atomic_ref/atomic_thread_fence
+#include <atomic>
+// allocator_traits/construct_at/destroy_at
+#include <memory>
+// optional
+#include <optional>
+// is_trivially_copyable/is_same
+#include <type_traits>
+
+#else
+
+#define BIZWEN_EXPORT export
+
+#endif
+
+namespace bizwen
+{
+// Chase-Lev工作窃取双端队列
+// 所有者线程在尾部push_back/pop_back，其他线程在头部steal
+// 与经典实现的环形数组不同，这里的环是块指针的环，扩容时只复制块指针而不复制元素
+// 由于窃取者会和所有者竞争读写同一元素，因此要求T可平凡复制且可用atomic_ref访问
+BIZWEN_EXPORT template <typename T, typename Alloc = ::std::allocator<T>>
+class ws_deque
+{
+    static_assert(::std::is_trivially_copyable_v<T>);
+    static_assert(alignof(T) >= ::std::atomic_ref<T>::required_alignment);
+
+    using atraits_t_ = ::std::allocator_traits<Alloc>;
+
+    // 窃取者无锁地读取块指针，因此不支持fancy pointer
+    static_assert(::std::is_same_v<typename atraits_t_::pointer, T *>);
+
+    // 块指针的环，size_是块的个数
+    // 扩容后旧环不会立刻释放，因为窃取者可能仍在读取它
+    struct ring_
+    {
+        T **blocks_{};
+        ::std::size_t size_{};
+        ring_ *retired_{};
+    };
+
+    using ring_alloc_t_ = typename atraits_t_::template rebind_alloc<ring_>;
+    using ctrl_alloc_t_ = typename atraits_t_::template rebind_alloc<T *>;
+
+#if __has_cpp_attribute(msvc::no_unique_address)
+    [[msvc::no_unique_address]] Alloc allocator_{};
+#else
+    [[no_unique_address]] Alloc allocator_{};
+#endif
+
+    // 窃取者修改top，所有者修改bottom，分开放置以避免伪共享
+    alignas(deque_detail::cache_line_size_v)::std::atomic<::std::ptrdiff_t> top_{};
+    alignas(deque_detail::cache_line_size_v)::std::atomic<::std::ptrdiff_t> bottom_{};
+    ::std::atomic<ring_ *> ring_ptr_{};
+
+    static constexpr auto block_pos_(::std::ptrdiff_t const index) noexcept
+    {
+        return static_cast<::std::size_t>(index) / deque_detail::block_elements_v<T>;
+    }
+
+    static constexpr T &at_(ring_ const *const r, ::std::ptrdiff_t const index) noexcept
+    {
+        auto const pos = static_cast<::std::size_t>(index);
+        auto const block = r->blocks_[pos / deque_detail::block_elements_v<T> % r->size_];
+        return block[pos % deque_detail::block_elements_v<T>];
+    }
+
+    constexpr void dealloc_ring_(ring_ *const r) noexcept
+    {
+        ctrl_alloc_t_(allocator_).deallocate(r->blocks_, r->size_);
+        ::std::destroy_at(r);
+        ring_alloc_t_(allocator_).deallocate(r, ::std::size_t(1));
+    }
+
+    // 扩容失败时释放新的块指针数组和已分配的块
+    struct grow_guard_
+    {
+        ws_deque *d;
+        T **blocks;
+        ::std::size_t size;
+        ::std::size_t first; // 新块的起始槽位
+        ::std::size_t count; // 已分配的新块个数
+
+        constexpr void release() noexcept
+        {
+            d = nullptr;
+        }
+
+        constexpr ~grow_guard_()
+        {
+            if (d != nullptr)
+            {
+                for (auto i = ::std::size_t(0); i != count; ++i)
+                {
+                    atraits_t_::deallocate(d->allocator_, blocks[(first + i) % size],
+                                           deque_detail::block_elements_v<T>);
+                }
+                ctrl_alloc_t_(d->allocator_).deallocate(blocks, size);
+            }
+        }
+    };
+
+    // 只由所有者调用
+    // 新环的大小是旧环的两倍，旧环的块按块序号[top块, top块+旧大小)重新映射到新环，
+    // 因此存活元素所在的块在新旧两个环中是同一个块，剩下的槽位分配新块
+    constexpr ring_ *grow_(ring_ *const old, ::std::ptrdiff_t const top)
+    {
+        auto const old_size = old == nullptr ? ::std::size_t(0) : old->size_;
+        auto const new_size = old_size == ::std::size_t(0) ? ::std::size_t(2) : old_size * ::std::size_t(2);
+        auto const blocks = ctrl_alloc_t_(allocator_).allocate(new_size); // may throw
+        auto const top_block = block_pos_(top);
+        grow_guard_ guard{this, blocks, new_size, (top_block + old_size) % new_size, ::std::size_t(0)};
+        for (auto i = ::std::size_t(0); i != old_size; ++i)
+        {
+            auto const block = top_block + i;
+            blocks[block % new_size] = old->blocks_[block % old_size];
+        }
+        // 新块占据的槽位在环中是连续的
+        for (; guard.count != new_size - old_size; ++guard.count)
+        {
+            blocks[(guard.first + guard.count) % new_size] =
+                atraits_t_::allocate(allocator_, deque_detail::block_elements_v<T>); // may throw
+        }
+        auto const r = ring_alloc_t_(allocator_).allocate(::std::size_t(1)); // may throw
+        guard.release();
+        ::std::construct_at(r, blocks, new_size, old);
+        ring_ptr_.store(r, ::std::memory_order_release);
+        return r;
+    }
+
+  public:
+    using value_type = T;
+    using size_type = ::std::size_t;
+    using allocator_type = Alloc;
+
+    constexpr ws_deque() noexcept(::std::is_nothrow_default_constructible_v<Alloc>)
+        requires ::std::default_initializable<Alloc>
+    = default;
+
+    explicit constexpr ws_deque(Alloc const &alloc) noexcept(::std::is_nothrow_copy_constructible_v<Alloc>)
+        : allocator_(alloc)
+    {
+    }
+
+    ws_deque(ws_deque const &) = delete;
+
+    ws_deque &operator=(ws_deque const &) = delete;
+
+    // 析构时不能有其他线程访问
+    constexpr ~ws_deque()
+    {
+        auto r = ring_ptr_.load(::std::memory_order_relaxed);
+        if (r != nullptr)
+        {
+            // 块只属于最新的环
+            for (auto i = ::std::size_t(0); i != r->size_; ++i)
+            {
+                atraits_t_::deallocate(allocator_, r->blocks_[i], deque_detail::block_elements_v<T>);
+            }
+        }
+        while (r != nullptr)
+        {
+            auto const retired = r->retired_;
+            dealloc_ring_(r);
+            r = retired;
+        }
+    }
+
+    constexpr Alloc get_allocator() const noexcept
+    {
+        return allocator_;
+    }
+
+    // 只由所有者调用
+    constexpr void push_back(T const &value)
+    {
+        auto const bottom = bottom_.load(::std::memory_order_relaxed);
+        auto const top = top_.load(::std::memory_order_acquire);
+        auto r = ring_ptr_.load(::std::memory_order_relaxed);
+        // 新元素所在块与top所在块在环中重叠时扩容
+        if (r == nullptr || block_pos_(bottom) - block_pos_(top) >= r->size_)
+        {
+            r = grow_(r, top); // may throw
+        }
+        ::std::atomic_ref<T>(at_(r, bottom)).store(value, ::std::memory_order_relaxed);
+        ::std::atomic_thread_fence(::std::memory_order_release);
+        bottom_.store(bottom + ::std::ptrdiff_t(1), ::std::memory_order_relaxed);
+    }
+
+    // 只由所有者调用，为空或最后一个元素被窃取时返回nullopt
+    constexpr ::std::optional<T> pop_back() noexcept
+    {
+        auto const bottom = bottom_.load(::std::memory_order_relaxed) - ::std::ptrdiff_t(1);
+        auto const r = ring_ptr_.load(::std::memory_order_relaxed);
+        bottom_.store(bottom, ::std::memory_order_relaxed);
+        ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+        auto top = top_.load(::std::memory_order_relaxed);
+        if (top > bottom)
+        {
+            bottom_.store(bottom + ::std::ptrdiff_t(1), ::std::memory_order_relaxed);
+            return ::std::nullopt;
+        }
+        auto const value = ::std::atomic_ref<T>(at_(r, bottom)).load(::std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // 最后一个元素，与窃取者竞争
+            auto const won = top_.compare_exchange_strong(top, top + ::std::ptrdiff_t(1), ::std::memory_order_seq_cst,
+                                                          ::std::memory_order_relaxed);
+            bottom_.store(bottom + ::std::ptrdiff_t(1), ::std::memory_order_relaxed);
+            if (!won)
+            {
+                return ::std::nullopt;
+            }
+        }
+        return value;
+    }
+
+    // 任意线程均可调用，为空或与其他线程竞争失败时返回nullopt
+    constexpr ::std::optional<T> steal() noexcept
+    {
+        auto top = top_.load(::std::memory_order_acquire);
+        ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+        auto const bottom = bottom_.load(::std::memory_order_acquire);
+        if (top >= bottom)
+        {
+            return ::std::nullopt;
+        }
+        auto const r = ring_ptr_.load(::std::memory_order_acquire);
+        // 可能读到被覆盖的值，此时CAS一定失败
+        auto const value = ::std::atomic_ref<T>(at_(r, top)).load(::std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(top, top + ::std::ptrdiff_t(1), ::std::memory_order_seq_cst,
+                                          ::std::memory_order_relaxed))
+        {
+            return ::std::nullopt;
+        }
+        return value;
+    }
+
+    // 并发时只是近似值
+    constexpr size_type size() const noexcept
+    {
+        auto const bottom = bottom_.load(::std::memory_order_relaxed);
+        auto const top = top_.load(::std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_type>(bottom - top) : size_type(0);
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return size() == size_type(0);
+    }
+};
+} // namespace bizwen
+
+#pragma pop_macro("BIZWEN_EXPORT")
+
+#endif